@@ -17,7 +17,9 @@
 #include <compare>
 #include <iosfwd>
 #include <sstream>
+#include <stdexcept>
 #include <cstring>
+#include <cmath>
 
 #include "integer_view.hpp"
 #include "integer_view_arithmetic.hpp"
@@ -255,6 +257,7 @@ struct integer_holder : AllocatorT
             assert(asz);
             *limbs = 0;
             ++sz;
+            sign = 1;
         }
         new (limbsdata) limbs_data{ .allocated_size = static_cast<uint32_t>(asz), .sign = (sign < 0) ? 1u : 0, .size = static_cast<uint32_t>(sz) };
         set_allocated(reinterpret_cast<limbs_data*>(limbsdata));
@@ -438,6 +441,21 @@ struct integer_holder : AllocatorT
         return !!ldata->sign;
     }
 
+    // grows the allocated storage to hold at least sz limbs, the value is kept;
+    // the capacity grows geometrically, so a sequence of in-place updates reallocates rarely
+    LimbT* allocated_reserve(size_t sz)
+    {
+        auto [ldata, limbs] = allocated_data_and_limbs();
+        if (ldata->allocated_size >= sz) return limbs;
+        size_t asz = (std::max)(sz, size_t{ ldata->allocated_size } + (ldata->allocated_size >> 1));
+        LimbT* limbsdata = allocate(asz + limbs_data_sizeof_in_limbs);
+        std::memcpy(limbsdata + limbs_data_sizeof_in_limbs, limbs, ldata->size * sizeof(LimbT));
+        limbs_data* newdata = new (limbsdata) limbs_data{ .allocated_size = static_cast<uint32_t>(asz), .sign = ldata->sign, .size = ldata->size };
+        deallocate(reinterpret_cast<LimbT*>(ldata), ldata->allocated_size + limbs_data_sizeof_in_limbs);
+        set_allocated(newdata);
+        return limbsdata + limbs_data_sizeof_in_limbs;
+    }
+
     inline bool is_negative() const noexcept
     {
         LimbT ctl = ctl_limb();
@@ -825,6 +843,23 @@ public:
         return *this;
     }
 
+    // replaces the value by the limbs, the allocated storage is reused if it is large enough
+    void assign(std::span<const LimbT> limbs, bool negative)
+    {
+        while (!limbs.empty() && !limbs.back()) limbs = limbs.first(limbs.size() - 1);
+        if (limbs.empty()) { *this = 0; return; }
+        if (aholder_.is_inplaced()) {
+            *this = basic_integer{ basic_integer_view<LimbT>{ limbs, negative ? -1 : 1 }, allocator() };
+            return;
+        }
+        detail::limbs_data* ldata = aholder_.allocated_data();
+        ldata->size = 0; // nothing to keep
+        LimbT* l = aholder_.allocated_reserve(limbs.size());
+        ldata = aholder_.allocated_data();
+        std::copy(limbs.begin(), limbs.end(), l);
+        allocated_set_size(ldata, l, limbs.size(), negative);
+    }
+
     explicit operator bool() const
     {
         return !aholder_.is_zero();
@@ -860,15 +895,31 @@ public:
         return result;
     }
     
+    // +=, -=, *= by a limb and the shifts reuse the allocated storage of the value (see add_inplace and others),
+    // an inplaced value is rebuilt, it needs no allocation until it outgrows the inplace limbs
     template <std::integral TermT>
-    inline basic_integer& operator+= (TermT r) { *this = *this + r; return *this; }
-    inline basic_integer& operator+= (basic_integer_view<LimbT> r) { *this = *this + r; return *this; }
-    inline basic_integer& operator+= (basic_integer const& r) { *this = *this + r; return *this; }
+    inline basic_integer& operator+= (TermT r)
+    {
+        if constexpr (sizeof(TermT) <= sizeof(LimbT)) {
+            return add_assign(basic_integer_view<LimbT>{ r }.decompose());
+        } else {
+            return add_assign(basic_integer<LimbT, 1 + sizeof(TermT) / sizeof(LimbT), AllocatorT>{ r }.decompose());
+        }
+    }
+    inline basic_integer& operator+= (basic_integer_view<LimbT> r) { return add_assign(r.decompose()); }
+    inline basic_integer& operator+= (basic_integer const& r) { return add_assign(r.decompose()); }
 
     template <std::integral TermT>
-    inline basic_integer& operator-= (TermT r) { *this = *this - r; return *this; }
-    inline basic_integer& operator-= (basic_integer_view<LimbT> r) { *this = *this - r; return *this; }
-    inline basic_integer& operator-= (basic_integer const& r) { *this = *this - r; return *this; }
+    inline basic_integer& operator-= (TermT r)
+    {
+        if constexpr (sizeof(TermT) <= sizeof(LimbT)) {
+            return sub_assign(basic_integer_view<LimbT>{ r }.decompose());
+        } else {
+            return sub_assign(basic_integer<LimbT, 1 + sizeof(TermT) / sizeof(LimbT), AllocatorT>{ r }.decompose());
+        }
+    }
+    inline basic_integer& operator-= (basic_integer_view<LimbT> r) { return sub_assign(r.decompose()); }
+    inline basic_integer& operator-= (basic_integer const& r) { return sub_assign(r.decompose()); }
 
     template <std::integral TermT>
     inline basic_integer& operator|= (TermT r) { *this = *this | r; return *this; }
@@ -881,7 +932,18 @@ public:
     inline basic_integer& operator&= (basic_integer const& r) { *this = *this & r; return *this; }
 
     template <std::integral MultiplierT>
-    inline basic_integer& operator*= (MultiplierT r) { *this = *this * r; return *this; }
+    inline basic_integer& operator*= (MultiplierT r)
+    {
+        if constexpr (sizeof(MultiplierT) <= sizeof(LimbT)) {
+            if constexpr (std::is_signed_v<MultiplierT>) {
+                if (mul1_inplace(r < 0 ? static_cast<LimbT>(LimbT{ 0 } - static_cast<LimbT>(r)) : static_cast<LimbT>(r), r < 0)) return *this;
+            } else {
+                if (mul1_inplace(static_cast<LimbT>(r), false)) return *this;
+            }
+        }
+        *this = *this * r;
+        return *this;
+    }
     inline basic_integer& operator*= (basic_integer_view<LimbT> r) { *this = *this * r; return *this; }
     inline basic_integer& operator*= (basic_integer const& r) { *this = *this * r; return *this; }
 
@@ -896,19 +958,52 @@ public:
     inline basic_integer& operator%= (basic_integer const& r) { *this = *this % r; return *this; }
 
     template <std::unsigned_integral ShiftOperandT>
-    inline basic_integer& operator<<= (ShiftOperandT r) { *this = *this << r; return *this; }
+    inline basic_integer& operator<<= (ShiftOperandT r)
+    {
+        if (!shift_left_inplace(r)) *this = *this << r;
+        return *this;
+    }
 
     template <std::unsigned_integral ShiftOperandT>
-    inline basic_integer& operator>>= (ShiftOperandT r) { *this = *this >> r; return *this; }
+    inline basic_integer& operator>>= (ShiftOperandT r)
+    {
+        if (!shift_right_inplace(r)) *this = *this >> r;
+        return *this;
+    }
 
     // return self / divider, r -> self
     basic_integer div_qr(basic_integer_view<LimbT> divider);
+
+    // self += b * c, self -= b * c; the product is accumulated into the limbs of the value,
+    // a multiplier of up to two limbs is applied row by row without any scratch
+    inline basic_integer& addmul(basic_integer_view<LimbT> b, basic_integer_view<LimbT> c) { return addmul_assign(b.decompose(), c.decompose(), false); }
+    inline basic_integer& submul(basic_integer_view<LimbT> b, basic_integer_view<LimbT> c) { return addmul_assign(b.decompose(), c.decompose(), true); }
+
+    template <std::integral MultiplierT>
+    inline basic_integer& addmul(basic_integer_view<LimbT> b, MultiplierT c)
+    {
+        if constexpr (sizeof(MultiplierT) <= sizeof(LimbT)) {
+            return addmul_assign(b.decompose(), basic_integer_view<LimbT>{ c }.decompose(), false);
+        } else {
+            return addmul_assign(b.decompose(), basic_integer<LimbT, 1 + sizeof(MultiplierT) / sizeof(LimbT), AllocatorT>{ c }.decompose(), false);
+        }
+    }
+
+    template <std::integral MultiplierT>
+    inline basic_integer& submul(basic_integer_view<LimbT> b, MultiplierT c)
+    {
+        if constexpr (sizeof(MultiplierT) <= sizeof(LimbT)) {
+            return addmul_assign(b.decompose(), basic_integer_view<LimbT>{ c }.decompose(), true);
+        } else {
+            return addmul_assign(b.decompose(), basic_integer<LimbT, 1 + sizeof(MultiplierT) / sizeof(LimbT), AllocatorT>{ c }.decompose(), true);
+        }
+    }
     
     inline int sgn() const noexcept { return aholder_.is_zero() ? 0 : (aholder_.is_negative() ? -1 : 1); }
 
     inline void negate() noexcept
     {
-        aholder_.negate();
+        if (!aholder_.is_zero()) aholder_.negate(); // zero is not signed
     }
 
     inline bool is_negative() const noexcept { return aholder_.is_negative(); }
@@ -964,6 +1059,50 @@ public:
         }
         return result;
     }
+
+private:
+    inline basic_integer& add_assign(limb_arithmetic::composition<LimbT> const& r)
+    {
+        if (!add_inplace(r)) *this = *this + r;
+        return *this;
+    }
+
+    inline basic_integer& sub_assign(limb_arithmetic::composition<LimbT> const& r)
+    {
+        return add_assign(limb_arithmetic::composition<LimbT>{ get<0>(r), get<1>(r), -get<2>(r) });
+    }
+
+    basic_integer& addmul_assign(limb_arithmetic::composition<LimbT> const& b, limb_arithmetic::composition<LimbT> const& c, bool subtract)
+    {
+        if (!addmul_inplace(b, c, subtract)) {
+            basic_integer p = build_new([&b, &c](auto& ih) { ih.init(limb_arithmetic::mul(b, c, ih.inplace_allocator())); });
+            if (subtract) *this -= p;
+            else *this += p;
+        }
+        return *this;
+    }
+
+    // the in-place kernels work on the allocated storage only and return false for an inplaced value,
+    // the caller falls back to the out-of-place operator then
+    bool add_inplace(limb_arithmetic::composition<LimbT> const& r);
+    bool addmul_inplace(limb_arithmetic::composition<LimbT> const& b, limb_arithmetic::composition<LimbT> const& c, bool subtract);
+    bool mul1_inplace(LimbT v, bool negative);
+    bool shift_left_inplace(size_t n);
+    bool shift_right_inplace(size_t n);
+
+    // the limbs of the allocated value without the leading zeros, the sign is reset for zero
+    void allocated_set_size(detail::limbs_data* ldata, LimbT* limbs, size_t sz, bool negative) noexcept
+    {
+        while (sz && !limbs[sz - 1]) --sz;
+        if (!sz) {
+            *limbs = 0;
+            ldata->size = 1;
+            ldata->sign = 0;
+            return;
+        }
+        ldata->size = static_cast<uint32_t>(sz);
+        ldata->sign = negative ? 1u : 0;
+    }
 };
 
 
@@ -1160,6 +1299,252 @@ basic_integer<LimbT, N, AllocatorT> basic_integer<LimbT, N, AllocatorT>::div_qr(
     });
 }
 
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool basic_integer<LimbT, N, AllocatorT>::add_inplace(limb_arithmetic::composition<LimbT> const& r)
+{
+    if (aholder_.is_inplaced()) return false;
+    auto [rlimbs, rmask, rsign] = r;
+    auto [ldata, limbs] = aholder_.allocated_data_and_limbs();
+    std::less<LimbT const*> lt;
+    if (!rlimbs.empty() && !lt(rlimbs.data(), limbs) && lt(rlimbs.data(), limbs + ldata->allocated_size)) {
+        return false; // r refers to the value itself
+    }
+
+    // r = rh * B^rl.size() + rl, rh != 0
+    LimbT rh = 0;
+    while (!rlimbs.empty()) {
+        rh = rlimbs.back() & rmask;
+        rmask = (std::numeric_limits<LimbT>::max)();
+        rlimbs = rlimbs.first(rlimbs.size() - 1);
+        if (rh) break;
+    }
+    if (!rh) return true;
+    const size_t rn = rlimbs.size() + 1;
+
+    size_t sn = ldata->size;
+    while (sn && !limbs[sn - 1]) --sn;
+    const bool rnegative = rsign < 0;
+    const bool negative = sn ? !!ldata->sign : rnegative;
+
+    if (negative == rnegative) {
+        const size_t n = (std::max)(sn, rn);
+        limbs = aholder_.allocated_reserve(n);
+        ldata = aholder_.allocated_data();
+        std::fill(limbs + sn, limbs + n, 0);
+        LimbT c = limb_arithmetic::uadd_inplace<LimbT>(limbs, rlimbs.data(), rlimbs.data() + rlimbs.size());
+        auto [c0, t0] = numetron::arithmetic::uadd1(limbs[rn - 1], rh);
+        auto [c1, t1] = numetron::arithmetic::uadd1(t0, c);
+        limbs[rn - 1] = t1;
+        c = limb_arithmetic::uadd_limb<LimbT>(limbs + rn, limbs + n, static_cast<LimbT>(c0 | c1));
+        if (c) {
+            ldata->size = static_cast<uint32_t>(n);
+            limbs = aholder_.allocated_reserve(n + 1);
+            ldata = aholder_.allocated_data();
+            limbs[n] = c;
+        }
+        allocated_set_size(ldata, limbs, n + !!c, negative);
+        return true;
+    }
+
+    // |self| <=> |r|
+    int cmp = sn < rn ? -1 : (sn > rn ? 1 : 0);
+    if (!cmp) {
+        cmp = limbs[rn - 1] < rh ? -1 : (limbs[rn - 1] > rh ? 1 : 0);
+        for (size_t i = rn - 1; !cmp && i-- > 0;) {
+            cmp = limbs[i] < rlimbs[i] ? -1 : (limbs[i] > rlimbs[i] ? 1 : 0);
+        }
+    }
+    if (cmp > 0) {
+        LimbT b = limb_arithmetic::usub_inplace<LimbT>(limbs, rlimbs.data(), rlimbs.data() + rlimbs.size());
+        auto [b0, t0] = numetron::arithmetic::usub1c(limbs[rn - 1], rh, b);
+        limbs[rn - 1] = t0;
+        limb_arithmetic::usub_limb<LimbT>(limbs + rn, limbs + sn, b0);
+        allocated_set_size(ldata, limbs, sn, negative);
+    } else {
+        // |r| - |self|, the sign of r
+        limbs = aholder_.allocated_reserve(rn);
+        ldata = aholder_.allocated_data();
+        std::fill(limbs + sn, limbs + rn, 0);
+        LimbT b = 0;
+        for (size_t i = 0; i < rn - 1; ++i) {
+            std::tie(b, limbs[i]) = numetron::arithmetic::usub1c(rlimbs[i], limbs[i], b);
+        }
+        std::tie(b, limbs[rn - 1]) = numetron::arithmetic::usub1c(rh, limbs[rn - 1], b);
+        allocated_set_size(ldata, limbs, rn, rnegative);
+    }
+    return true;
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool basic_integer<LimbT, N, AllocatorT>::addmul_inplace(limb_arithmetic::composition<LimbT> const& b, limb_arithmetic::composition<LimbT> const& c, bool subtract)
+{
+    using buffer_t = detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type>;
+    constexpr LimbT no_mask = (std::numeric_limits<LimbT>::max)();
+
+    if (aholder_.is_inplaced()) return false;
+    auto [ldata, limbs] = aholder_.allocated_data_and_limbs();
+    auto [bl, bmask, bsign] = b;
+    auto [cl, cmask, csign] = c;
+    std::less<LimbT const*> lt;
+    auto refers_self = [lt, limbs, asz = ldata->allocated_size](std::span<const LimbT> sp) {
+        return !sp.empty() && !lt(sp.data(), limbs) && lt(sp.data(), limbs + asz);
+    };
+    if (refers_self(bl) || refers_self(cl)) return false;
+
+    // a masked high limb belongs to an inplaced operand, the limbs of such an operand are copied
+    buffer_t bbuf(bmask == no_mask ? 0 : bl.size(), allocator()), cbuf(cmask == no_mask ? 0 : cl.size(), allocator());
+    auto significant = [](std::span<const LimbT> l, LimbT mask, buffer_t& buf) {
+        if (mask != no_mask && !l.empty()) {
+            std::copy(l.begin(), l.end(), buf.data());
+            buf.data()[l.size() - 1] &= mask;
+            l = std::span<const LimbT>{ buf.data(), l.size() };
+        }
+        while (!l.empty() && !l.back()) l = l.first(l.size() - 1);
+        return l;
+    };
+    bl = significant(bl, bmask, bbuf);
+    cl = significant(cl, cmask, cbuf);
+    if (bl.empty() || cl.empty()) return true;
+    if (bl.size() < cl.size()) std::swap(bl, cl);
+    const size_t bn = bl.size(), cn = cl.size();
+
+    size_t an = ldata->size;
+    while (an && !limbs[an - 1]) --an;
+    const bool pnegative = ((bsign < 0) != (csign < 0)) != subtract;
+    const bool negative = an ? !!ldata->sign : pnegative;
+    const bool add = negative == pnegative;
+
+    // the value is extended to k limbs, the carry (or the borrow) out of them is cy
+    size_t k = (std::max)(an, bn + cn);
+    ldata->size = static_cast<uint32_t>(an);
+    limbs = aholder_.allocated_reserve(k);
+    ldata = aholder_.allocated_data();
+    std::fill(limbs + an, limbs + k, 0);
+
+    LimbT cy = 0;
+    if (cn <= 2) {
+        // row by row, every row is a single-limb multiply-accumulate; for longer multipliers the basecase
+        // multiplication and one addition pass are faster
+        for (size_t j = 0; j < cn; ++j) {
+            LimbT* p = limbs + j;
+            if (add) {
+                LimbT h = limb_arithmetic::umul1_add<LimbT>(bl.data(), bl.data() + bn, cl[j], p);
+                cy += limb_arithmetic::uadd_limb<LimbT>(p, limbs + k, h);
+            } else {
+                LimbT h = limb_arithmetic::umul1_sub<LimbT>(bl.data(), bl.data() + bn, cl[j], p);
+                cy += limb_arithmetic::usub_limb<LimbT>(p, limbs + k, h);
+            }
+        }
+    } else {
+        detail::small_array<LimbT, 4 * NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type> prod(bn + cn, allocator());
+        LimbT* pb = prod.data(), * pe = pb + bn + cn;
+        std::fill(limb_arithmetic::umul_dispatch<LimbT>(bl.data(), bn, cl.data(), cn, pb, allocator()), pe, 0);
+        if (add) {
+            cy = limb_arithmetic::uadd_inplace<LimbT>(limbs, pb, pe);
+            cy = limb_arithmetic::uadd_limb<LimbT>(limbs + bn + cn, limbs + k, cy);
+        } else {
+            cy = limb_arithmetic::usub_inplace<LimbT>(limbs, pb, pe);
+            cy = limb_arithmetic::usub_limb<LimbT>(limbs + bn + cn, limbs + k, cy);
+        }
+    }
+
+    bool rnegative = negative;
+    if (add) {
+        if (cy) {
+            ldata->size = static_cast<uint32_t>(k);
+            limbs = aholder_.allocated_reserve(k + 1);
+            ldata = aholder_.allocated_data();
+            limbs[k++] = cy;
+        }
+    } else if (cy) {
+        // |self| < |b * c|: the limbs hold B^k - (|b * c| - |self|), the difference is their two's complement
+        size_t i = 0;
+        while (!limbs[i]) ++i;
+        limbs[i] = LimbT{ 0 } - limbs[i];
+        for (++i; i < k; ++i) limbs[i] = ~limbs[i];
+        rnegative = !negative;
+    }
+    allocated_set_size(ldata, limbs, k, rnegative);
+    return true;
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool basic_integer<LimbT, N, AllocatorT>::mul1_inplace(LimbT v, bool negative)
+{
+    if (aholder_.is_inplaced()) return false;
+    auto [ldata, limbs] = aholder_.allocated_data_and_limbs();
+    size_t sn = ldata->size;
+    while (sn && !limbs[sn - 1]) --sn;
+    if (!sn || !v) {
+        allocated_set_size(ldata, limbs, 0, false);
+        return true;
+    }
+    negative = negative != !!ldata->sign;
+    if (LimbT c = limb_arithmetic::umul1_inplace<LimbT>(limbs, limbs + sn, v); c) {
+        ldata->size = static_cast<uint32_t>(sn);
+        limbs = aholder_.allocated_reserve(sn + 1);
+        ldata = aholder_.allocated_data();
+        limbs[sn++] = c;
+    }
+    allocated_set_size(ldata, limbs, sn, negative);
+    return true;
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool basic_integer<LimbT, N, AllocatorT>::shift_left_inplace(size_t n)
+{
+    if (aholder_.is_inplaced()) return false;
+    constexpr size_t limb_bits = std::numeric_limits<LimbT>::digits;
+    auto [ldata, limbs] = aholder_.allocated_data_and_limbs();
+    size_t sn = ldata->size;
+    while (sn && !limbs[sn - 1]) --sn;
+    if (!sn) return true;
+    const size_t q = n / limb_bits;
+    const unsigned int shift = static_cast<unsigned int>(n % limb_bits);
+    const bool negative = !!ldata->sign;
+
+    const bool carry = shift && (limbs[sn - 1] >> (limb_bits - shift));
+    ldata->size = static_cast<uint32_t>(sn);
+    limbs = aholder_.allocated_reserve(sn + q + carry);
+    ldata = aholder_.allocated_data();
+    if (shift) {
+        LimbT c = limb_arithmetic::ushift_left<LimbT>(std::span{ limbs, sn }, shift);
+        if (carry) limbs[sn++] = c;
+    }
+    if (q) {
+        std::copy_backward(limbs, limbs + sn, limbs + sn + q);
+        std::fill(limbs, limbs + q, 0);
+    }
+    allocated_set_size(ldata, limbs, sn + q, negative);
+    return true;
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool basic_integer<LimbT, N, AllocatorT>::shift_right_inplace(size_t n)
+{
+    if (aholder_.is_inplaced()) return false;
+    constexpr size_t limb_bits = std::numeric_limits<LimbT>::digits;
+    auto [ldata, limbs] = aholder_.allocated_data_and_limbs();
+    size_t sn = ldata->size;
+    while (sn && !limbs[sn - 1]) --sn;
+    const size_t q = n / limb_bits;
+    if (q >= sn) {
+        allocated_set_size(ldata, limbs, 0, false);
+        return true;
+    }
+    const unsigned int shift = static_cast<unsigned int>(n % limb_bits);
+    sn -= q;
+    if (q) {
+        std::copy(limbs + q, limbs + q + sn, limbs);
+    }
+    if (shift) {
+        LimbT h = limbs[sn - 1];
+        limb_arithmetic::ushift_right<LimbT>(h, std::span<const LimbT>{ limbs, sn - 1 }, shift, limbs);
+        limbs[sn - 1] = h;
+    }
+    allocated_set_size(ldata, limbs, sn, !!ldata->sign);
+    return true;
+}
 
 using integer = basic_integer<uint64_t, 1>;
 
@@ -1458,10 +1843,305 @@ inline basic_integer<LimbT, LN, AllocatorLT> operator>> (basic_integer<LimbT, LN
     return l.build_new([lv = (basic_integer_view<LimbT>)l, n](auto& ih) { ih.init(shift_right(lv, n, ih.inplace_allocator())); });
 }
 
+// #################### addmul, submul
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline basic_integer<LimbT, N, AllocatorT>& addmul(basic_integer<LimbT, N, AllocatorT>& acc, std::type_identity_t<basic_integer_view<LimbT>> b, std::type_identity_t<basic_integer_view<LimbT>> c)
+{
+    return acc.addmul(b, c);
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT, std::integral MultiplierT>
+inline basic_integer<LimbT, N, AllocatorT>& addmul(basic_integer<LimbT, N, AllocatorT>& acc, std::type_identity_t<basic_integer_view<LimbT>> b, MultiplierT c)
+{
+    return acc.addmul(b, c);
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline basic_integer<LimbT, N, AllocatorT>& submul(basic_integer<LimbT, N, AllocatorT>& acc, std::type_identity_t<basic_integer_view<LimbT>> b, std::type_identity_t<basic_integer_view<LimbT>> c)
+{
+    return acc.submul(b, c);
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT, std::integral MultiplierT>
+inline basic_integer<LimbT, N, AllocatorT>& submul(basic_integer<LimbT, N, AllocatorT>& acc, std::type_identity_t<basic_integer_view<LimbT>> b, MultiplierT c)
+{
+    return acc.submul(b, c);
+}
+
 template <std::unsigned_integral LimbT, size_t LN, std::unsigned_integral NT, typename AllocatorLT>
 inline basic_integer<LimbT, LN, AllocatorLT> pow(basic_integer<LimbT, LN, AllocatorLT> const& l, NT n)
 {
     return l.build_new([lv = (basic_integer_view<LimbT>)l, n](auto& ih) { ih.init(pow(lv, n, ih.inplace_allocator())); });
 }
 
+// #################### divexact
+// l / r when r is known to divide l; the result is unspecified otherwise
+template <std::unsigned_integral LimbT, size_t LN, typename AllocatorLT>
+inline basic_integer<LimbT, LN, AllocatorLT> divexact(basic_integer<LimbT, LN, AllocatorLT> const& l, std::type_identity_t<basic_integer_view<LimbT>> rv)
+{
+    return l.build_new([lv = (basic_integer_view<LimbT>)l, rv](auto& ih) { ih.init(divexact(lv, rv, ih.inplace_allocator())); });
+}
+
+template <std::unsigned_integral LimbT, size_t LN, size_t RN, typename AllocatorLT, typename AllocatorRT>
+inline basic_integer<LimbT, LN, AllocatorLT> divexact(basic_integer<LimbT, LN, AllocatorLT> const& l, basic_integer<LimbT, RN, AllocatorRT> const& r)
+{
+    return divexact(l, (basic_integer_view<LimbT>)r);
+}
+
+template <std::unsigned_integral LimbT, size_t LN, typename AllocatorLT, std::integral DividerT>
+inline basic_integer<LimbT, LN, AllocatorLT> divexact(basic_integer<LimbT, LN, AllocatorLT> const& l, DividerT r)
+{
+    if constexpr (sizeof(DividerT) <= sizeof(LimbT)) {
+        return divexact(l, basic_integer_view<LimbT>{ r });
+    } else {
+        return divexact(l, basic_integer<LimbT, 1 + sizeof(DividerT) / sizeof(LimbT), AllocatorLT>{ r });
+    }
+}
+
+// #################### gcd
+template <std::unsigned_integral LimbT, size_t LN, typename AllocatorLT>
+inline basic_integer<LimbT, LN, AllocatorLT> gcd(basic_integer<LimbT, LN, AllocatorLT> const& l, std::type_identity_t<basic_integer_view<LimbT>> rv)
+{
+    return l.build_new([lv = (basic_integer_view<LimbT>)l, rv](auto& ih) { ih.init(gcd(lv, rv, ih.inplace_allocator())); });
+}
+
+template <std::unsigned_integral LimbT, size_t LN, size_t RN, typename AllocatorLT, typename AllocatorRT>
+inline basic_integer<LimbT, LN, AllocatorLT> gcd(basic_integer<LimbT, LN, AllocatorLT> const& l, basic_integer<LimbT, RN, AllocatorRT> const& r)
+{
+    return gcd(l, (basic_integer_view<LimbT>)r);
+}
+
+template <std::unsigned_integral LimbT, size_t LN, typename AllocatorLT, std::integral RT>
+inline basic_integer<LimbT, LN, AllocatorLT> gcd(basic_integer<LimbT, LN, AllocatorLT> const& l, RT r)
+{
+    if constexpr (sizeof(RT) <= sizeof(LimbT)) {
+        return gcd(l, basic_integer_view<LimbT>{ r });
+    } else {
+        return gcd(l, basic_integer<LimbT, 1 + sizeof(RT) / sizeof(LimbT), AllocatorLT>{ r });
+    }
+}
+
+template <std::unsigned_integral LimbT, size_t RN, typename AllocatorRT, std::integral LT>
+inline basic_integer<LimbT, RN, AllocatorRT> gcd(LT l, basic_integer<LimbT, RN, AllocatorRT> const& r)
+{
+    return gcd(r, l);
+}
+
+// #################### gcdext, invert
+// g = gcd(a, b) = s a + t b, g >= 0; the results are written into the storage of g, s and t, which may be the operands
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void gcdext(basic_integer<LimbT, N, AllocatorT>& g, basic_integer<LimbT, N, AllocatorT>& s, basic_integer<LimbT, N, AllocatorT>& t,
+    std::type_identity_t<basic_integer_view<LimbT>> a, std::type_identity_t<basic_integer_view<LimbT>> b)
+{
+    using buffer_t = detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT>;
+    a.with_limbs([&g, &s, &t, b](std::span<const LimbT> al, int asign) {
+        b.with_limbs([&g, &s, &t, al, asign](std::span<const LimbT> bl, int bsign) {
+            const size_t an = al.size(), bn = bl.size(), gn = (std::max)(an, bn);
+            buffer_t buf(gn + an + bn + 2, g.allocator());
+            LimbT* gl = buf.data(), * sl = gl + gn, * tl = sl + bn + 1;
+            auto [grn, srn, trn, ssign] = limb_arithmetic::ugcdext<LimbT>(al.data(), an, bl.data(), bn, gl, sl, tl, g.allocator());
+            g.assign(std::span<const LimbT>{ gl, grn }, false);
+            s.assign(std::span<const LimbT>{ sl, srn }, (ssign < 0) != (asign < 0));
+            t.assign(std::span<const LimbT>{ tl, trn }, (ssign > 0) != (bsign < 0));
+        });
+    });
+}
+
+// returns {gcd(a, b), s, t}: gcd(a, b) = s a + t b
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline std::tuple<basic_integer<LimbT, N, AllocatorT>, basic_integer<LimbT, N, AllocatorT>, basic_integer<LimbT, N, AllocatorT>>
+gcdext(basic_integer<LimbT, N, AllocatorT> const& a, std::type_identity_t<basic_integer_view<LimbT>> b)
+{
+    std::tuple<basic_integer<LimbT, N, AllocatorT>, basic_integer<LimbT, N, AllocatorT>, basic_integer<LimbT, N, AllocatorT>> result{
+        basic_integer<LimbT, N, AllocatorT>{ 0, a.allocator() }, basic_integer<LimbT, N, AllocatorT>{ 0, a.allocator() }, basic_integer<LimbT, N, AllocatorT>{ 0, a.allocator() } };
+    gcdext(get<0>(result), get<1>(result), get<2>(result), a, b);
+    return result;
+}
+
+// the inverse of a modulo |m| in [0, |m|) -> r; returns false and leaves r unchanged if there is none (gcd(a, m) != 1 or m = 0)
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool invert(basic_integer<LimbT, N, AllocatorT>& r, std::type_identity_t<basic_integer_view<LimbT>> a, std::type_identity_t<basic_integer_view<LimbT>> m)
+{
+    using buffer_t = detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT>;
+    return a.with_limbs([&r, m](std::span<const LimbT> al, int asign) {
+        return m.with_limbs([&r, al, asign](std::span<const LimbT> ml, int) {
+            while (!ml.empty() && !ml.back()) ml = ml.first(ml.size() - 1);
+            if (ml.empty()) return false;
+            buffer_t buf(ml.size(), r.allocator());
+            auto rn = limb_arithmetic::uinvert<LimbT>(al.data(), al.size(), asign < 0, ml.data(), ml.size(), buf.data(), r.allocator());
+            if (!rn) return false;
+            r.assign(std::span<const LimbT>{ buf.data(), *rn }, false);
+            return true;
+        });
+    });
+}
+
+// returns the inverse of a modulo |m| in [0, |m|); throws std::domain_error if there is none
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline basic_integer<LimbT, N, AllocatorT> invert(basic_integer<LimbT, N, AllocatorT> const& a, std::type_identity_t<basic_integer_view<LimbT>> m)
+{
+    basic_integer<LimbT, N, AllocatorT> r{ 0, a.allocator() };
+    if (!invert(r, a, m)) throw std::domain_error("invert: the value is not invertible modulo m");
+    return r;
+}
+
+// #################### isqrt, sqrtrem, iroot, is_perfect_square, is_perfect_power
+// floor(sqrt(a)); throws std::domain_error for a negative value
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline basic_integer<LimbT, N, AllocatorT> isqrt(basic_integer<LimbT, N, AllocatorT> const& a)
+{
+    if (a.sgn() < 0) throw std::domain_error("isqrt: negative value");
+    return a.build_new([av = (basic_integer_view<LimbT>)a](auto& ih) { ih.init(isqrt(av, ih.inplace_allocator())); });
+}
+
+// s = floor(sqrt(a)), r = a - s^2; the results are written into the storage of s and r, which may be the operand;
+// throws std::domain_error for a negative value
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void sqrtrem(basic_integer<LimbT, N, AllocatorT>& s, basic_integer<LimbT, N, AllocatorT>& r, std::type_identity_t<basic_integer_view<LimbT>> a)
+{
+    using buffer_t = detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT>;
+    a.with_limbs([&s, &r](std::span<const LimbT> al, int asign) {
+        while (!al.empty() && !al.back()) al = al.first(al.size() - 1);
+        if (asign < 0 && !al.empty()) throw std::domain_error("sqrtrem: negative value");
+        const size_t an = al.size(), sn = (an + 1) / 2;
+        buffer_t buf(sn + an, s.allocator());
+        auto [srn, rrn] = limb_arithmetic::usqrtrem<LimbT>(al.data(), an, buf.data(), buf.data() + sn, s.allocator());
+        s.assign(std::span<const LimbT>{ buf.data(), srn }, false);
+        r.assign(std::span<const LimbT>{ buf.data() + sn, rrn }, false);
+    });
+}
+
+// returns {s, r}: s = floor(sqrt(a)), r = a - s^2; throws std::domain_error for a negative value
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline std::pair<basic_integer<LimbT, N, AllocatorT>, basic_integer<LimbT, N, AllocatorT>> sqrtrem(basic_integer<LimbT, N, AllocatorT> const& a)
+{
+    std::pair<basic_integer<LimbT, N, AllocatorT>, basic_integer<LimbT, N, AllocatorT>> result{
+        basic_integer<LimbT, N, AllocatorT>{ 0, a.allocator() }, basic_integer<LimbT, N, AllocatorT>{ 0, a.allocator() } };
+    sqrtrem(result.first, result.second, a);
+    return result;
+}
+
+// the k-th root of a truncated toward zero; throws std::domain_error for k = 0 and for an even root of a negative value
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+basic_integer<LimbT, N, AllocatorT> iroot(basic_integer<LimbT, N, AllocatorT> const& a, unsigned int k)
+{
+    using integer_t = basic_integer<LimbT, N, AllocatorT>;
+    constexpr size_t limb_bits = std::numeric_limits<LimbT>::digits;
+
+    if (!k) throw std::domain_error("iroot: zero degree");
+    if (a.sgn() < 0) {
+        if (!(k & 1)) throw std::domain_error("iroot: even root of a negative value");
+        return -iroot(-a, k);
+    }
+    if (k == 1 || a < 2) return a;
+    if (k == 2) return isqrt(a);
+
+    // log2(a) from the two leading limbs
+    const auto [bits, lg] = ((basic_integer_view<LimbT>)a).with_limbs([](std::span<const LimbT> al, int) {
+        while (!al.back()) al = al.first(al.size() - 1);
+        const size_t n = al.size();
+        double top = static_cast<double>(al[n - 1]);
+        if (n > 1) top = std::ldexp(top, limb_bits) + static_cast<double>(al[n - 2]);
+        return std::pair{ (n - 1) * limb_bits + std::bit_width(al[n - 1]), std::log2(top) + static_cast<double>((n - (n > 1 ? 2 : 1)) * limb_bits) };
+    });
+
+    // a < 2^k
+    if (bits <= k) return integer_t{ 1, a.allocator() };
+
+    // the estimate of a short root comes from the floating point and is rounded up, a longer one is the root of the
+    // leading part of a carrying half of the bits of the result, so Newton's steps below start close above the root
+    const size_t rbits = (bits + k - 1) / k;
+    integer_t x{ 0, a.allocator() };
+    if (rbits <= 32) {
+        x = static_cast<uint64_t>(std::exp2(lg / k) * (1 + 0x1p-32)) + 1;
+    } else {
+        const size_t t = rbits / 2;
+        x = (iroot(a >> (k * t), k) + 1) << t;
+    }
+
+    // x' = ((k - 1) x + a / x^(k - 1)) / k; a step from below the root lands above it (AM-GM), from above the steps
+    // decrease to the root and stop there
+    auto step = [&a, k](integer_t const& x) { return (x * (k - 1) + a / pow(x, k - 1)) / k; };
+    integer_t y = step(x);
+    if (y > x) {
+        x = std::move(y);
+        y = step(x);
+    }
+    while (y < x) {
+        x = std::move(y);
+        y = step(x);
+    }
+    return x;
+}
+
+// true if a = x^2 for an integer x; non-squares are mostly rejected by residues before any allocation
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool is_perfect_square(basic_integer<LimbT, N, AllocatorT> const& a)
+{
+    using buffer_t = detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT>;
+    return ((basic_integer_view<LimbT>)a).with_limbs([&a](std::span<const LimbT> al, int asign) {
+        while (!al.empty() && !al.back()) al = al.first(al.size() - 1);
+        if (al.empty()) return true;
+        if (asign < 0 || !limb_arithmetic::usquare_candidate(al.data(), al.size())) return false;
+        const size_t sn = (al.size() + 1) / 2;
+        buffer_t buf(sn + al.size(), a.allocator());
+        return !limb_arithmetic::usqrtrem<LimbT>(al.data(), al.size(), buf.data(), buf.data() + sn, a.allocator()).second;
+    });
+}
+
+// true if a = x^k for integers x and k >= 2; 0, 1 and -1 are perfect powers
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool is_perfect_power(basic_integer<LimbT, N, AllocatorT> const& a)
+{
+    using integer_t = basic_integer<LimbT, N, AllocatorT>;
+    constexpr size_t limb_bits = std::numeric_limits<LimbT>::digits;
+
+    const bool negative = a.sgn() < 0;
+    integer_t m = negative ? -a : a;
+    if (m < 2) return true;
+
+    const auto [bits, tz] = ((basic_integer_view<LimbT>)m).with_limbs([](std::span<const LimbT> ml, int) {
+        while (!ml.back()) ml = ml.first(ml.size() - 1);
+        size_t i = 0;
+        while (!ml[i]) ++i;
+        return std::pair{ (ml.size() - 1) * limb_bits + std::bit_width(ml.back()), i * limb_bits + std::countr_zero(ml[i]) };
+    });
+
+    // x^k = m means that k divides the multiplicity of 2 in m, and x^(pq) is a p-th power, so the prime degrees suffice;
+    // only the odd ones apply to a negative value
+    if (!negative && !(tz & 1) && is_perfect_square(m)) return true;
+    auto is_prime = [](uint64_t k) {
+        for (uint64_t p = 3; p * p <= k; p += 2) {
+            if (!(k % p)) return false;
+        }
+        return true;
+    };
+
+    // a k-th power is a k-th power residue modulo the primes p = 1 (mod k), m^((p - 1) / k) = 0 or 1 (mod p);
+    // a few of such primes reject almost all of the other values before the root is taken
+    auto is_power_residue = [&m, &is_prime](unsigned int k) {
+        constexpr uint64_t pmax = (std::min<uint64_t>)(std::numeric_limits<LimbT>::max(), 0xffffffff);
+        return ((basic_integer_view<LimbT>)m).with_limbs([k, &is_prime](std::span<const LimbT> ml, int) {
+            int count = 0;
+            for (uint64_t p = 2 * uint64_t{ k } + 1; count < 3 && p <= pmax; p += 2 * uint64_t{ k }) {
+                if (!is_prime(p)) continue;
+                ++count;
+                uint64_t r = limb_arithmetic::umod1<LimbT>(ml, static_cast<LimbT>(p)), x = 1;
+                if (!r) continue;
+                for (uint64_t e = (p - 1) / k; e; e >>= 1, r = r * r % p) {
+                    if (e & 1) x = x * r % p;
+                }
+                if (x != 1) return false;
+            }
+            return true;
+        });
+    };
+
+    for (unsigned int k = 3; k <= bits; k += 2) {
+        if ((tz && tz % k) || !is_prime(k) || !is_power_residue(k)) continue;
+        if (pow(iroot(m, k), k) == m) return true;
+    }
+    return false;
+}
+
 }
@@ -0,0 +1,196 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+#include "basic_integer.hpp"
+#include "limb_arithmetic/udiv.hpp"
+
+namespace numetron {
+
+// A divisor prepared once for many divisions: the normalized limbs and the shift, the inverse of a one-limb
+// divisor for udivby1, and the Newton reciprocal (see limb_arithmetic::uinv) of a large one.
+// The quotient is truncated toward zero, the remainder takes the sign of the dividend, as in basic_integer::div_qr.
+template <std::unsigned_integral LimbT, typename AllocatorT = std::allocator<LimbT>>
+class basic_integer_divisor
+{
+    using limbs_t = std::vector<LimbT, AllocatorT>;
+
+public:
+    explicit basic_integer_divisor(basic_integer_view<LimbT> d, AllocatorT const& alloc = AllocatorT{})
+        : norm_{ alloc }, inv_{ alloc }
+    {
+        d.with_limbs([this](std::span<const LimbT> limbs, int sign) {
+            while (!limbs.empty() && !limbs.back()) limbs = limbs.first(limbs.size() - 1);
+            if (limbs.empty()) [[unlikely]] {
+                throw std::runtime_error("division by zero");
+            }
+            sign_ = sign;
+            shift_ = numetron::arithmetic::count_leading_zeros(limbs.back());
+            norm_.assign(limbs.begin(), limbs.end());
+        });
+
+        if (norm_.size() == 1) {
+            // the inverse in the form udivby1 expects, see also radix_power_table
+            const LimbT d0 = norm_.front();
+            const int l = std::numeric_limits<LimbT>::digits - shift_;
+            LimbT u1 = (shift_ ? (LimbT{ 1 } << l) : 0) - d0;
+            invd_ = numetron::arithmetic::udiv2by1<LimbT>(u1, 0, d0).first;
+            return;
+        }
+
+        if (shift_) {
+            limb_arithmetic::ushift_left<LimbT>(std::span{ norm_ }, static_cast<unsigned int>(shift_));
+        }
+        if constexpr (sizeof(LimbT) == 8) {
+            if (norm_.size() >= NUMETRON_DIV_NEWTON_THRESHOLD) {
+                inv_.resize(norm_.size());
+                limb_arithmetic::uinv<LimbT>(norm_.data(), norm_.size(), inv_.data(), AllocatorT{ alloc });
+            }
+        }
+    }
+
+    template <size_t N, typename AllocatorDT>
+    explicit basic_integer_divisor(basic_integer<LimbT, N, AllocatorDT> const& d, AllocatorT const& alloc = AllocatorT{})
+        : basic_integer_divisor{ (basic_integer_view<LimbT>)d, alloc }
+    {}
+
+    inline int sgn() const noexcept { return sign_; }
+
+    // the size of the divisor in limbs
+    inline size_t size() const noexcept { return norm_.size(); }
+
+    template <size_t N, typename AllocatorUT>
+    [[nodiscard]] basic_integer<LimbT, N, AllocatorUT> div(basic_integer<LimbT, N, AllocatorUT> const& u) const
+    {
+        return u.build_new([this, uv = (basic_integer_view<LimbT>)u](auto& qih) {
+            uv.with_limbs([this, &qih](std::span<const LimbT> ulimbs, int usign) {
+                while (!ulimbs.empty() && !ulimbs.back()) ulimbs = ulimbs.first(ulimbs.size() - 1);
+                if (ulimbs.size() < size()) {
+                    qih.init_zero();
+                    return;
+                }
+                auto alloc = qih.inplace_allocator();
+                const size_t qsz = ulimbs.size();
+                std::tuple<LimbT*, size_t, size_t, int> result{ alloc.allocate(qsz), qsz, qsz, usign * sign_ };
+                NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&alloc, &result] { alloc.deallocate(get<0>(result), get<2>(result)); });
+                detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> r(size(), norm_.get_allocator());
+                divmod(ulimbs, get<0>(result), r.data());
+                trim(result);
+                qih.init(result);
+            });
+        });
+    }
+
+    template <size_t N, typename AllocatorUT>
+    [[nodiscard]] basic_integer<LimbT, N, AllocatorUT> mod(basic_integer<LimbT, N, AllocatorUT> const& u) const
+    {
+        return u.build_new([this, uv = (basic_integer_view<LimbT>)u](auto& rih) {
+            uv.with_limbs([this, &rih](std::span<const LimbT> ulimbs, int usign) {
+                while (!ulimbs.empty() && !ulimbs.back()) ulimbs = ulimbs.first(ulimbs.size() - 1);
+                auto alloc = rih.inplace_allocator();
+                if (ulimbs.size() < size()) {
+                    if (ulimbs.empty()) {
+                        rih.init_zero();
+                        return;
+                    }
+                    std::tuple<LimbT*, size_t, size_t, int> result{ alloc.allocate(ulimbs.size()), ulimbs.size(), ulimbs.size(), usign };
+                    std::copy(ulimbs.begin(), ulimbs.end(), get<0>(result));
+                    rih.init(result);
+                    return;
+                }
+                std::tuple<LimbT*, size_t, size_t, int> result{ alloc.allocate(size()), size(), size(), usign };
+                NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&alloc, &result] { alloc.deallocate(get<0>(result), get<2>(result)); });
+                detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> q(ulimbs.size(), norm_.get_allocator());
+                divmod(ulimbs, q.data(), get<0>(result));
+                trim(result);
+                rih.init(result);
+            });
+        });
+    }
+
+    // {u / d, u % d}
+    template <size_t N, typename AllocatorUT>
+    [[nodiscard]] std::pair<basic_integer<LimbT, N, AllocatorUT>, basic_integer<LimbT, N, AllocatorUT>> divmod(basic_integer<LimbT, N, AllocatorUT> const& u) const
+    {
+        using integer_t = basic_integer<LimbT, N, AllocatorUT>;
+        auto uv = (basic_integer_view<LimbT>)u;
+        return uv.with_limbs([this, &u](std::span<const LimbT> ulimbs, int usign) -> std::pair<integer_t, integer_t> {
+            while (!ulimbs.empty() && !ulimbs.back()) ulimbs = ulimbs.first(ulimbs.size() - 1);
+            if (ulimbs.size() < size()) {
+                return { integer_t{ 0, u.allocator() }, u };
+            }
+            detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> r(size(), norm_.get_allocator());
+            integer_t q = u.build_new([this, ulimbs, usign, &r](auto& qih) {
+                auto alloc = qih.inplace_allocator();
+                const size_t qsz = ulimbs.size();
+                std::tuple<LimbT*, size_t, size_t, int> result{ alloc.allocate(qsz), qsz, qsz, usign * sign_ };
+                NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&alloc, &result] { alloc.deallocate(get<0>(result), get<2>(result)); });
+                divmod(ulimbs, get<0>(result), r.data());
+                trim(result);
+                qih.init(result);
+            });
+            size_t rsz = r.size();
+            while (rsz && !r.data()[rsz - 1]) --rsz;
+            integer_t rem{ basic_integer_view<LimbT>{ std::span<const LimbT>{ r.data(), rsz }, usign }, u.allocator() };
+            return { std::move(q), std::move(rem) };
+        });
+    }
+
+private:
+    // {u} / d -> q[un], u mod d -> r[size()], the quotient limbs above un - size() are zeroed
+    // prereqs: u has no leading zeros, un >= size()
+    void divmod(std::span<const LimbT> u, LimbT* q, LimbT* r) const
+    {
+        const size_t un = u.size(), dn = norm_.size();
+        if (dn == 1) {
+            std::copy(u.begin(), u.end(), q);
+            *r = limb_arithmetic::udivby1<LimbT>(std::span{ q, un }, norm_.front(), invd_, std::numeric_limits<LimbT>::digits - shift_);
+            return;
+        }
+
+        AllocatorT alloc{ norm_.get_allocator() };
+        detail::small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> ubuf(un, alloc);
+        std::copy(u.begin(), u.end(), ubuf.data());
+        std::fill(q + un - dn + 1, q + un, 0);
+        std::span<LimbT> ul = ubuf.span().first(un - 1);
+        LimbT rh = limb_arithmetic::udiv_dnorm<LimbT>(ubuf.back(), ul, shift_, norm_.back(), std::span<const LimbT>{ norm_.data(), dn - 1 },
+            q + un - dn, alloc, inv_.empty() ? nullptr : inv_.data());
+        std::copy(ul.begin(), ul.end(), r);
+        r[dn - 1] = rh;
+    }
+
+    static void trim(std::tuple<LimbT*, size_t, size_t, int>& result) noexcept
+    {
+        while (get<1>(result) && !*(get<0>(result) + get<1>(result) - 1)) {
+            --get<1>(result);
+        }
+    }
+
+    limbs_t norm_; // the divisor shifted left by shift_, a one-limb divisor is kept as is
+    limbs_t inv_;  // the reciprocal of norm_ if it is large enough for the Newton division
+    LimbT invd_ = 0;
+    int shift_ = 0;
+    int sign_ = 1;
+};
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT, typename AllocatorDT>
+inline basic_integer<LimbT, N, AllocatorT> operator/ (basic_integer<LimbT, N, AllocatorT> const& l, basic_integer_divisor<LimbT, AllocatorDT> const& d)
+{
+    return d.div(l);
+}
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT, typename AllocatorDT>
+inline basic_integer<LimbT, N, AllocatorT> operator% (basic_integer<LimbT, N, AllocatorT> const& l, basic_integer_divisor<LimbT, AllocatorDT> const& d)
+{
+    return d.mod(l);
+}
+
+using integer_divisor = basic_integer_divisor<uint64_t>;
+
+}
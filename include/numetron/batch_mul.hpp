@@ -0,0 +1,27 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <span>
+#include <stdexcept>
+
+#include "limb_arithmetic/ubatch_mul.hpp"
+
+namespace numetron {
+
+// The products of count pairs of limbs-limb numbers in one call. The batch is a structure of arrays: a and b hold
+// limbs rows of count limbs each, the row i keeps the limb i of every number, so a[i * count + k] is the limb i of the
+// k-th number; out receives 2 * limbs rows of count limbs laid out the same way and must not overlap the operands.
+template <std::unsigned_integral LimbT>
+void batch_mul(std::span<const LimbT> a_soa, std::span<const LimbT> b_soa, size_t limbs, size_t count, std::span<LimbT> out)
+{
+    if (!limbs || !count) return;
+    if (a_soa.size() / limbs < count || b_soa.size() / limbs < count || out.size() / (2 * limbs) < count) {
+        throw std::invalid_argument("batch_mul: the spans are shorter than the batch");
+    }
+    limb_arithmetic::ubatch_mul<LimbT>(a_soa.data(), b_soa.data(), limbs, count, out.data());
+}
+
+}
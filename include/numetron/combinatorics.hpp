@@ -0,0 +1,250 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "basic_integer.hpp"
+#include "limb_arithmetic/uprod.hpp"
+
+// binomial(n, k) multiplies out n (n - 1) ... (n - k + 1) and divides by k! when k is below this bound or n / k
+// exceeds it, and otherwise collects the prime factorization of the result, which needs a sieve up to n
+#ifndef NUMETRON_BINOMIAL_PRODUCT_THRESHOLD
+#   define NUMETRON_BINOMIAL_PRODUCT_THRESHOLD 32
+#endif
+
+namespace numetron::detail {
+
+template <std::unsigned_integral LimbT>
+LimbT combinatorics_argument(unsigned long long n, const char* what)
+{
+    if (n > (std::numeric_limits<LimbT>::max)()) throw std::domain_error(what);
+    return static_cast<LimbT>(n);
+}
+
+// the odd primes up to n in ascending order, the sieve of Eratosthenes over the odd numbers
+template <std::unsigned_integral LimbT, typename AllocatorT>
+std::vector<LimbT, AllocatorT> odd_primes(LimbT n, AllocatorT const& alloc)
+{
+    std::vector<LimbT, AllocatorT> result(alloc);
+    if (n < 3) return result;
+
+    // the index i stands for 2i + 1, the square of 2i + 1 is at 2i (i + 1)
+    const size_t m = static_cast<size_t>((n - 1) / 2);
+    std::vector<bool> composite(m + 1);
+    for (size_t i = 1; 2 * i * (i + 1) <= m; ++i) {
+        if (composite[i]) continue;
+        for (size_t j = 2 * i * (i + 1); j <= m; j += 2 * i + 1) composite[j] = true;
+    }
+    // pi(x) < 1.25506 x / ln x
+    result.reserve(static_cast<size_t>(1.25506 * static_cast<double>(n) / std::log(static_cast<double>(n))) + 1);
+    for (size_t i = 1; i <= m; ++i) {
+        if (!composite[i]) result.push_back(static_cast<LimbT>(2 * i + 1));
+    }
+    return result;
+}
+
+// Packs single limb factors into limb-sized partial products, which become the leaves of a product tree.
+template <std::unsigned_integral LimbT, typename AllocatorT>
+class factor_packer
+{
+public:
+    explicit factor_packer(AllocatorT const& alloc) : limbs_{ alloc } {}
+
+    void push(LimbT x)
+    {
+        auto [h, l] = arithmetic::umul1(acc_, x);
+        if (h) {
+            limbs_.push_back(acc_);
+            acc_ = x;
+        } else {
+            acc_ = l;
+        }
+    }
+
+    // the product of the pushed factors -> r, the packer is emptied
+    template <size_t N>
+    void product(basic_integer<LimbT, N, AllocatorT>& r)
+    {
+        if (acc_ != 1 || limbs_.empty()) limbs_.push_back(acc_);
+        acc_ = 1;
+        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> buf(limbs_.size(), r.allocator());
+        const size_t n = limb_arithmetic::uprod<LimbT>(limbs_.data(), limbs_.size(), buf.data(), r.allocator());
+        r.assign(std::span<const LimbT>{ buf.data(), n }, false);
+        limbs_.clear();
+    }
+
+private:
+    std::vector<LimbT, AllocatorT> limbs_;
+    LimbT acc_ = 1;
+};
+
+// the product of p^e(p) over the primes p -> r; the exponents are consumed bit by bit from the top: every bit is a
+// product tree of the primes that have it set, the partial result is squared between the bits
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT, typename ExponentF>
+void prime_power_product(basic_integer<LimbT, N, AllocatorT>& r, std::span<const LimbT> primes, ExponentF const& exponent)
+{
+    std::vector<LimbT, AllocatorT> e(primes.size(), r.allocator());
+    LimbT emax = 0;
+    for (size_t i = 0; i < primes.size(); ++i) {
+        e[i] = exponent(primes[i]);
+        emax |= e[i];
+    }
+
+    factor_packer<LimbT, AllocatorT> packer{ r.allocator() };
+    basic_integer<LimbT, N, AllocatorT> t{ 0, r.allocator() };
+    r = 1;
+    for (int k = std::bit_width(emax); k-- > 0;) {
+        r = r * r;
+        for (size_t i = 0; i < primes.size(); ++i) {
+            if ((e[i] >> k) & 1) packer.push(primes[i]);
+        }
+        packer.product(t);
+        r *= t;
+    }
+}
+
+// the odd part of n! -> r by the prime swing: oddfact(n) = oddfact(n / 2)^2 oddswing(n), where the odd prime p divides
+// the swing n! / (n / 2)!^2 with the exponent sum_i (floor(n / p^i) mod 2)
+// prereqs: primes holds the odd primes up to n
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void odd_factorial(basic_integer<LimbT, N, AllocatorT>& r, LimbT n, std::span<const LimbT> primes)
+{
+    basic_integer<LimbT, N, AllocatorT> swing{ 0, r.allocator() };
+    r = 1;
+    for (int j = std::bit_width(n); j-- > 0;) {
+        const LimbT m = n >> j;
+        if (m < 3) continue; // oddfact(1) = oddfact(2) = 1
+        const size_t pn = static_cast<size_t>(std::upper_bound(primes.begin(), primes.end(), m) - primes.begin());
+        prime_power_product(swing, primes.first(pn), [m](LimbT p) {
+            LimbT e = 0;
+            for (LimbT q = m / p; q; q /= p) e += q & 1;
+            return e;
+        });
+        r = r * r;
+        r *= swing;
+    }
+}
+
+}
+
+namespace numetron {
+
+// n! -> r
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void factorial(basic_integer<LimbT, N, AllocatorT>& r, unsigned long long n)
+{
+    const LimbT m = detail::combinatorics_argument<LimbT>(n, "factorial: the argument does not fit in a limb");
+    auto primes = detail::odd_primes(m, r.allocator());
+    detail::odd_factorial(r, m, std::span<const LimbT>{ primes });
+    // the power of 2 in n! is n - popcount(n)
+    r <<= static_cast<LimbT>(m - std::popcount(m));
+}
+
+// n!! = n (n - 2) (n - 4) ... -> r
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void double_factorial(basic_integer<LimbT, N, AllocatorT>& r, unsigned long long n)
+{
+    const LimbT m = detail::combinatorics_argument<LimbT>(n, "double_factorial: the argument does not fit in a limb");
+    if (!(m & 1)) {
+        // (2k)!! = 2^k k!
+        factorial(r, m / 2);
+        r <<= static_cast<LimbT>(m / 2);
+        return;
+    }
+    // the odd multiples of p^i up to n number (floor(n / p^i) + 1) / 2
+    auto primes = detail::odd_primes(m, r.allocator());
+    detail::prime_power_product(r, std::span<const LimbT>{ primes }, [m](LimbT p) {
+        LimbT e = 0;
+        for (LimbT q = m / p; q; q /= p) e += (q + 1) / 2;
+        return e;
+    });
+}
+
+// the binomial coefficient C(n, k) -> r, 0 if k > n
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void binomial(basic_integer<LimbT, N, AllocatorT>& r, unsigned long long n, unsigned long long k)
+{
+    const LimbT m = detail::combinatorics_argument<LimbT>(n, "binomial: the argument does not fit in a limb");
+    if (k > n) {
+        r = 0;
+        return;
+    }
+    const LimbT j = static_cast<LimbT>((std::min)(k, n - k));
+    if (!j) {
+        r = 1;
+        return;
+    }
+
+    if (j < NUMETRON_BINOMIAL_PRODUCT_THRESHOLD || m / NUMETRON_BINOMIAL_PRODUCT_THRESHOLD > j) {
+        detail::factor_packer<LimbT, AllocatorT> packer{ r.allocator() };
+        for (LimbT i = m - j + 1; i <= m && i; ++i) packer.push(i);
+        packer.product(r);
+        basic_integer<LimbT, N, AllocatorT> d{ 0, r.allocator() };
+        factorial(d, j);
+        r = divexact(r, d);
+        return;
+    }
+
+    // Kummer: the exponent of p is the number of borrows in the subtraction n - k in base p,
+    // sum_i (floor(n / p^i) - floor(k / p^i) - floor((n - k) / p^i))
+    auto primes = detail::odd_primes(m, r.allocator());
+    detail::prime_power_product(r, std::span<const LimbT>{ primes }, [m, j](LimbT p) {
+        LimbT e = 0;
+        for (LimbT a = m, b = j, c = m - j; a >= p;) {
+            a /= p; b /= p; c /= p;
+            e += a - b - c;
+        }
+        return e;
+    });
+    r <<= static_cast<LimbT>(std::popcount(j) + std::popcount(static_cast<LimbT>(m - j)) - std::popcount(m));
+}
+
+// the product of the primes up to n -> r
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+void primorial(basic_integer<LimbT, N, AllocatorT>& r, unsigned long long n)
+{
+    const LimbT m = detail::combinatorics_argument<LimbT>(n, "primorial: the argument does not fit in a limb");
+    detail::factor_packer<LimbT, AllocatorT> packer{ r.allocator() };
+    if (m >= 2) packer.push(2);
+    for (LimbT p : detail::odd_primes(m, r.allocator())) packer.push(p);
+    packer.product(r);
+}
+
+inline integer factorial(unsigned long long n)
+{
+    integer r;
+    factorial(r, n);
+    return r;
+}
+
+inline integer double_factorial(unsigned long long n)
+{
+    integer r;
+    double_factorial(r, n);
+    return r;
+}
+
+inline integer binomial(unsigned long long n, unsigned long long k)
+{
+    integer r;
+    binomial(r, n, k);
+    return r;
+}
+
+inline integer primorial(unsigned long long n)
+{
+    integer r;
+    primorial(r, n);
+    return r;
+}
+
+}
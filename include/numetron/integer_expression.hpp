@@ -0,0 +1,403 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+
+#include "basic_integer.hpp"
+
+// Opt-in lazy arithmetic over basic_integer. lazy(a) * b + c * d - e >> k builds the expression tree and computes
+// nothing; the value is computed when the expression is converted to a basic_integer (or by eval()).
+// The evaluation allocates the result once, for the upper bound of its size, and one scratch arena shared by all
+// the intermediate values: the nodes evaluated one after another reuse the same part of the arena, and a sum,
+// a difference or a shift is computed directly in the limbs of its destination, so the final node writes
+// the result without a temporary.
+// The expression refers to its integer operands, they must outlive the evaluation:
+//     integer r = (lazy(a) * b + lazy(c) * d - e) >> 3u;
+
+namespace numetron {
+
+template <std::unsigned_integral LimbT>
+struct integer_expression_value
+{
+    LimbT const* data;
+    size_t size; // without leading zeros
+    bool negative;
+};
+
+template <typename ExpressionT, std::unsigned_integral LimbT> class integer_expression_base;
+
+template <typename T>
+concept integer_expression = requires { typename T::limb_type; } && std::derived_from<T, integer_expression_base<T, typename T::limb_type>>;
+
+namespace detail {
+
+template <std::unsigned_integral LimbT>
+inline integer_expression_value<LimbT> expression_value(LimbT const* data, size_t size, bool negative) noexcept
+{
+    while (size && !data[size - 1]) --size;
+    return { data, size, size && negative };
+}
+
+// x + y -> r[max(x.size, y.size) + 1], r may be x.data
+template <std::unsigned_integral LimbT>
+inline integer_expression_value<LimbT> expression_add(integer_expression_value<LimbT> x, integer_expression_value<LimbT> y, LimbT* r) noexcept
+{
+    if (!y.size) {
+        if (x.data != r) std::copy(x.data, x.data + x.size, r);
+        return { r, x.size, x.negative };
+    }
+    if (!x.size) {
+        std::copy(y.data, y.data + y.size, r);
+        return { r, y.size, y.negative };
+    }
+    std::span<const LimbT> xs{ x.data, x.size }, ys{ y.data, y.size };
+    if (x.negative == y.negative) {
+        const size_t n = (std::max)(x.size, y.size);
+        r[n] = limb_arithmetic::uadd<LimbT>(xs, ys, std::span{ r, n });
+        return expression_value<LimbT>(r, n + 1, x.negative);
+    }
+    if (limb_arithmetic::compare<LimbT>(xs, (std::numeric_limits<LimbT>::max)(), ys, (std::numeric_limits<LimbT>::max)(), 1) < 0) {
+        std::swap(x, y);
+    }
+    LimbT const* ub = x.data;
+    LimbT* rb = r;
+    limb_arithmetic::usub_unchecked<LimbT>(ub, x.data + x.size, y.data, y.data + y.size, rb);
+    return expression_value<LimbT>(r, x.size, x.negative);
+}
+
+}
+
+// Every node provides:
+//   bound()   - the upper bound of the value size in limbs;
+//   slot()    - the limbs the parent reserves for the value, zero if the node refers to the limbs of its operand;
+//   scratch() - the arena limbs the evaluation needs;
+//   evaluate(r, arena, alloc) - computes the value into r[bound()], only a terminal may return its own limbs instead.
+template <typename ExpressionT, std::unsigned_integral LimbT>
+class integer_expression_base
+{
+public:
+    template <size_t N, typename AllocatorT>
+    inline operator basic_integer<LimbT, N, AllocatorT>() const
+    {
+        return eval<basic_integer<LimbT, N, AllocatorT>, AllocatorT>();
+    }
+
+    template <typename IntegerT = basic_integer<LimbT>, typename AllocatorT = std::allocator<LimbT>>
+    [[nodiscard]] IntegerT eval(AllocatorT const& alloc = AllocatorT{}) const
+    {
+        ExpressionT const& e = static_cast<ExpressionT const&>(*this);
+        return IntegerT{ [&e, &alloc](auto& ih) {
+            const size_t rn = e.bound();
+            if (!rn) {
+                ih.init_zero();
+                return;
+            }
+            auto ialloc = ih.inplace_allocator();
+            std::tuple<LimbT*, size_t, size_t, int> result{ ialloc.allocate(rn), 0, rn, 1 };
+            NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&ialloc, &result] { ialloc.deallocate(get<0>(result), get<2>(result)); });
+            AllocatorT salloc{ alloc };
+            detail::small_array<LimbT, 4 * NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> arena(e.scratch(), salloc);
+            integer_expression_value<LimbT> v = e.evaluate(get<0>(result), arena.data(), salloc);
+            if (v.data != get<0>(result)) {
+                std::copy(v.data, v.data + v.size, get<0>(result));
+            }
+            get<1>(result) = v.size;
+            get<3>(result) = v.negative ? -1 : 1;
+            ih.init(result);
+        }, alloc };
+    }
+};
+
+template <std::unsigned_integral LimbT>
+class integer_terminal : public integer_expression_base<integer_terminal<LimbT>, LimbT>
+{
+public:
+    using limb_type = LimbT;
+
+    explicit integer_terminal(basic_integer_view<LimbT> v) noexcept : value_{ v } {}
+
+    inline size_t bound() const noexcept { return value_.size(); }
+
+    // a masked high limb is not a plain limb, such an operand is copied
+    inline size_t slot() const noexcept
+    {
+        return get<1>(value_.decompose()) == (std::numeric_limits<LimbT>::max)() ? 0 : value_.size();
+    }
+
+    inline size_t scratch() const noexcept { return 0; }
+
+    template <typename AllocatorT>
+    inline integer_expression_value<LimbT> evaluate(LimbT* r, LimbT*, AllocatorT&) const noexcept
+    {
+        auto [limbs, mask, sign] = value_.decompose();
+        if (mask != (std::numeric_limits<LimbT>::max)() && !limbs.empty()) {
+            std::copy(limbs.begin(), limbs.end(), r);
+            r[limbs.size() - 1] &= mask;
+            return detail::expression_value<LimbT>(r, limbs.size(), sign < 0);
+        }
+        return detail::expression_value<LimbT>(limbs.data(), limbs.size(), sign < 0);
+    }
+
+private:
+    basic_integer_view<LimbT> value_;
+};
+
+// l + r or l - r; l is evaluated in the destination and r is added to it in place
+template <typename LT, typename RT, bool SubtractV>
+class integer_sum : public integer_expression_base<integer_sum<LT, RT, SubtractV>, typename LT::limb_type>
+{
+public:
+    using limb_type = typename LT::limb_type;
+
+    integer_sum(LT const& l, RT const& r) : l_{ l }, r_{ r } {}
+
+    inline size_t bound() const noexcept { return (std::max)(l_.bound(), r_.bound()) + 1; }
+    inline size_t slot() const noexcept { return bound(); }
+    inline size_t scratch() const noexcept { return (std::max)(l_.scratch(), r_.slot() + r_.scratch()); }
+
+    template <typename AllocatorT>
+    inline integer_expression_value<limb_type> evaluate(limb_type* r, limb_type* arena, AllocatorT& alloc) const
+    {
+        integer_expression_value<limb_type> x = l_.evaluate(r, arena, alloc);
+        integer_expression_value<limb_type> y = r_.evaluate(arena, arena + r_.slot(), alloc);
+        if constexpr (SubtractV) {
+            y.negative = y.size && !y.negative;
+        }
+        return detail::expression_add(x, y, r);
+    }
+
+private:
+    LT l_;
+    RT r_;
+};
+
+template <typename LT, typename RT>
+class integer_product : public integer_expression_base<integer_product<LT, RT>, typename LT::limb_type>
+{
+public:
+    using limb_type = typename LT::limb_type;
+
+    integer_product(LT const& l, RT const& r) : l_{ l }, r_{ r } {}
+
+    inline size_t bound() const noexcept { return l_.bound() + r_.bound(); }
+    inline size_t slot() const noexcept { return bound(); }
+    inline size_t scratch() const noexcept { return l_.slot() + (std::max)(l_.scratch(), r_.slot() + r_.scratch()); }
+
+    template <typename AllocatorT>
+    inline integer_expression_value<limb_type> evaluate(limb_type* r, limb_type* arena, AllocatorT& alloc) const
+    {
+        limb_type* rarena = arena + l_.slot();
+        integer_expression_value<limb_type> x = l_.evaluate(arena, rarena, alloc);
+        integer_expression_value<limb_type> y = r_.evaluate(rarena, rarena + r_.slot(), alloc);
+        if (!x.size || !y.size) return { r, 0, false };
+        limb_type* re = limb_arithmetic::umul_dispatch<limb_type>(x.data, x.size, y.data, y.size, r, alloc);
+        return detail::expression_value<limb_type>(r, re - r, x.negative != y.negative);
+    }
+
+private:
+    LT l_;
+    RT r_;
+};
+
+// e << n; e is evaluated in the destination above the n / limb_bits low limbs and shifted there
+template <typename ET>
+class integer_shift_left : public integer_expression_base<integer_shift_left<ET>, typename ET::limb_type>
+{
+public:
+    using limb_type = typename ET::limb_type;
+    static constexpr size_t limb_bits = std::numeric_limits<limb_type>::digits;
+
+    integer_shift_left(ET const& e, size_t n) : e_{ e }, n_{ n } {}
+
+    inline size_t bound() const noexcept { return e_.bound() + n_ / limb_bits + 1; }
+    inline size_t slot() const noexcept { return bound(); }
+    inline size_t scratch() const noexcept { return e_.scratch(); }
+
+    template <typename AllocatorT>
+    inline integer_expression_value<limb_type> evaluate(limb_type* r, limb_type* arena, AllocatorT& alloc) const
+    {
+        const size_t q = n_ / limb_bits;
+        const unsigned int shift = static_cast<unsigned int>(n_ % limb_bits);
+        integer_expression_value<limb_type> x = e_.evaluate(r + q, arena, alloc);
+        if (!x.size) return { r, 0, false };
+        std::fill(r, r + q, 0);
+        limb_type* rl = r + q;
+        if (!shift) {
+            if (x.data != rl) std::copy(x.data, x.data + x.size, rl);
+            return { r, x.size + q, x.negative };
+        }
+        limb_type h = x.data[x.size - 1];
+        rl[x.size] = limb_arithmetic::ushift_left<limb_type>(h, std::span<const limb_type>{ x.data, x.size - 1 }, shift, rl);
+        rl[x.size - 1] = h;
+        return detail::expression_value<limb_type>(r, x.size + q + 1, x.negative);
+    }
+
+private:
+    ET e_;
+    size_t n_;
+};
+
+// e >> n, the magnitude is shifted as basic_integer::operator>> does; e is evaluated in the destination
+// and shifted down in place, so the bound is the one of e
+template <typename ET>
+class integer_shift_right : public integer_expression_base<integer_shift_right<ET>, typename ET::limb_type>
+{
+public:
+    using limb_type = typename ET::limb_type;
+    static constexpr size_t limb_bits = std::numeric_limits<limb_type>::digits;
+
+    integer_shift_right(ET const& e, size_t n) : e_{ e }, n_{ n } {}
+
+    inline size_t bound() const noexcept { return e_.bound(); }
+    inline size_t slot() const noexcept { return bound(); }
+    inline size_t scratch() const noexcept { return e_.scratch(); }
+
+    template <typename AllocatorT>
+    inline integer_expression_value<limb_type> evaluate(limb_type* r, limb_type* arena, AllocatorT& alloc) const
+    {
+        const size_t q = n_ / limb_bits;
+        const unsigned int shift = static_cast<unsigned int>(n_ % limb_bits);
+        integer_expression_value<limb_type> x = e_.evaluate(r, arena, alloc);
+        if (x.size <= q) return { r, 0, false };
+        const size_t n = x.size - q;
+        if (!shift) {
+            if (x.data != r || q) std::copy(x.data + q, x.data + x.size, r);
+            return { r, n, x.negative };
+        }
+        limb_type h = x.data[x.size - 1];
+        limb_arithmetic::ushift_right<limb_type>(h, std::span<const limb_type>{ x.data + q, n - 1 }, shift, r);
+        r[n - 1] = h;
+        return detail::expression_value<limb_type>(r, n, x.negative);
+    }
+
+private:
+    ET e_;
+    size_t n_;
+};
+
+template <typename ET>
+class integer_negation : public integer_expression_base<integer_negation<ET>, typename ET::limb_type>
+{
+public:
+    using limb_type = typename ET::limb_type;
+
+    explicit integer_negation(ET const& e) : e_{ e } {}
+
+    inline size_t bound() const noexcept { return e_.bound(); }
+    inline size_t slot() const noexcept { return e_.slot(); }
+    inline size_t scratch() const noexcept { return e_.scratch(); }
+
+    template <typename AllocatorT>
+    inline integer_expression_value<limb_type> evaluate(limb_type* r, limb_type* arena, AllocatorT& alloc) const
+    {
+        integer_expression_value<limb_type> x = e_.evaluate(r, arena, alloc);
+        x.negative = x.size && !x.negative;
+        return x;
+    }
+
+private:
+    ET e_;
+};
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline integer_terminal<LimbT> lazy(basic_integer<LimbT, N, AllocatorT> const& v) noexcept
+{
+    return integer_terminal<LimbT>{ (basic_integer_view<LimbT>)v };
+}
+
+template <std::unsigned_integral LimbT>
+inline integer_terminal<LimbT> lazy(basic_integer_view<LimbT> v) noexcept
+{
+    return integer_terminal<LimbT>{ v };
+}
+
+namespace detail {
+
+template <std::unsigned_integral LimbT, integer_expression ET>
+requires(std::is_same_v<typename ET::limb_type, LimbT>)
+inline ET const& expression_operand(ET const& e) noexcept { return e; }
+
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+inline integer_terminal<LimbT> expression_operand(basic_integer<LimbT, N, AllocatorT> const& v) noexcept { return lazy(v); }
+
+template <std::unsigned_integral LimbT>
+inline integer_terminal<LimbT> expression_operand(basic_integer_view<LimbT> v) noexcept { return lazy(v); }
+
+template <std::unsigned_integral LimbT, std::integral T>
+requires(sizeof(T) <= sizeof(LimbT))
+inline integer_terminal<LimbT> expression_operand(T v) noexcept { return integer_terminal<LimbT>{ basic_integer_view<LimbT>{ v } }; }
+
+template <typename LimbT, typename T>
+using expression_operand_t = std::remove_cvref_t<decltype(expression_operand<LimbT>(std::declval<T const&>()))>;
+
+template <typename T, typename LimbT>
+concept expression_operand_of = requires(T const& v) { expression_operand<LimbT>(v); };
+
+}
+
+// #################### expression operators
+template <integer_expression LT, detail::expression_operand_of<typename LT::limb_type> RT>
+inline integer_sum<LT, detail::expression_operand_t<typename LT::limb_type, RT>, false> operator+ (LT const& l, RT const& r)
+{
+    return { l, detail::expression_operand<typename LT::limb_type>(r) };
+}
+
+template <typename LT, integer_expression RT>
+requires(!integer_expression<LT> && detail::expression_operand_of<LT, typename RT::limb_type>)
+inline integer_sum<detail::expression_operand_t<typename RT::limb_type, LT>, RT, false> operator+ (LT const& l, RT const& r)
+{
+    return { detail::expression_operand<typename RT::limb_type>(l), r };
+}
+
+template <integer_expression LT, detail::expression_operand_of<typename LT::limb_type> RT>
+inline integer_sum<LT, detail::expression_operand_t<typename LT::limb_type, RT>, true> operator- (LT const& l, RT const& r)
+{
+    return { l, detail::expression_operand<typename LT::limb_type>(r) };
+}
+
+template <typename LT, integer_expression RT>
+requires(!integer_expression<LT> && detail::expression_operand_of<LT, typename RT::limb_type>)
+inline integer_sum<detail::expression_operand_t<typename RT::limb_type, LT>, RT, true> operator- (LT const& l, RT const& r)
+{
+    return { detail::expression_operand<typename RT::limb_type>(l), r };
+}
+
+template <integer_expression LT, detail::expression_operand_of<typename LT::limb_type> RT>
+inline integer_product<LT, detail::expression_operand_t<typename LT::limb_type, RT>> operator* (LT const& l, RT const& r)
+{
+    return { l, detail::expression_operand<typename LT::limb_type>(r) };
+}
+
+template <typename LT, integer_expression RT>
+requires(!integer_expression<LT> && detail::expression_operand_of<LT, typename RT::limb_type>)
+inline integer_product<detail::expression_operand_t<typename RT::limb_type, LT>, RT> operator* (LT const& l, RT const& r)
+{
+    return { detail::expression_operand<typename RT::limb_type>(l), r };
+}
+
+template <integer_expression ET>
+inline integer_negation<ET> operator- (ET const& e)
+{
+    return integer_negation<ET>{ e };
+}
+
+template <integer_expression ET, std::unsigned_integral NT>
+inline integer_shift_left<ET> operator<< (ET const& e, NT n)
+{
+    return integer_shift_left<ET>{ e, static_cast<size_t>(n) };
+}
+
+template <integer_expression ET, std::unsigned_integral NT>
+inline integer_shift_right<ET> operator>> (ET const& e, NT n)
+{
+    return integer_shift_right<ET>{ e, static_cast<size_t>(n) };
+}
+
+}
@@ -9,6 +9,9 @@
 
 #include "integer_view.hpp"
 #include "limb_arithmetic.hpp"
+#include "limb_arithmetic/udivexact.hpp"
+#include "limb_arithmetic/ugcd.hpp"
+#include "limb_arithmetic/usqrt.hpp"
 
 // to do: look at https://github.com/google/double-conversion
 
@@ -133,6 +136,68 @@ requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_
     });
 }
 
+// l / r for an r that divides l exactly; the quotient is computed from the low limbs without a remainder
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
+[[nodiscard]] std::tuple<std::remove_cv_t<LimbT>*, size_t, size_t, int> divexact(basic_integer_view<LimbT> l, basic_integer_view<LimbT> r, AllocatorT&& alloc)
+{
+    using limb_t = std::remove_cv_t<LimbT>;
+    using alloc_traits_t = std::allocator_traits<std::remove_cvref_t<AllocatorT>>;
+    return l.with_limbs([r, &alloc](std::span<const LimbT> llimbs, int lsign) {
+        return r.with_limbs([llimbs, lsign, &alloc](std::span<const LimbT> rlimbs, int rsign) {
+            while (!rlimbs.empty() && !rlimbs.back()) rlimbs = rlimbs.first(rlimbs.size() - 1);
+            if (rlimbs.empty()) [[unlikely]] throw std::runtime_error("division by zero");
+            std::tuple<limb_t*, size_t, size_t, int> result{ nullptr, 0, 0, !(lsign + rsign) ? -1 : 1 };
+            if (llimbs.size() < rlimbs.size()) return result;
+            get<2>(result) = llimbs.size();
+            get<0>(result) = alloc_traits_t::allocate(alloc, get<2>(result));
+            NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&alloc, &result] { alloc_traits_t::deallocate(alloc, get<0>(result), get<2>(result)); });
+            get<1>(result) = limb_arithmetic::udivexact<limb_t>(llimbs.data(), llimbs.size(), rlimbs.data(), rlimbs.size(), get<0>(result), std::allocator<limb_t>{});
+            return result;
+        });
+    });
+}
+
+// the greatest common divisor of |l| and |r|, gcd(0, 0) = 0
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
+[[nodiscard]] std::tuple<std::remove_cv_t<LimbT>*, size_t, size_t, int> gcd(basic_integer_view<LimbT> l, basic_integer_view<LimbT> r, AllocatorT&& alloc)
+{
+    using limb_t = std::remove_cv_t<LimbT>;
+    using alloc_traits_t = std::allocator_traits<std::remove_cvref_t<AllocatorT>>;
+    return l.with_limbs([r, &alloc](std::span<const LimbT> llimbs, int) {
+        return r.with_limbs([llimbs, &alloc](std::span<const LimbT> rlimbs, int) {
+            std::tuple<limb_t*, size_t, size_t, int> result{ nullptr, 0, 0, 1 };
+            size_t margsz = (std::max)(llimbs.size(), rlimbs.size());
+            if (!margsz) [[unlikely]] return result;
+            get<2>(result) = margsz;
+            get<0>(result) = alloc_traits_t::allocate(alloc, margsz);
+            NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&alloc, &result] { alloc_traits_t::deallocate(alloc, get<0>(result), get<2>(result)); });
+            get<1>(result) = limb_arithmetic::ugcd<limb_t>(llimbs.data(), llimbs.size(), rlimbs.data(), rlimbs.size(), get<0>(result), std::allocator<limb_t>{});
+            return result;
+        });
+    });
+}
+
+// floor(sqrt(|l|))
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
+[[nodiscard]] std::tuple<std::remove_cv_t<LimbT>*, size_t, size_t, int> isqrt(basic_integer_view<LimbT> l, AllocatorT&& alloc)
+{
+    using limb_t = std::remove_cv_t<LimbT>;
+    using alloc_traits_t = std::allocator_traits<std::remove_cvref_t<AllocatorT>>;
+    return l.with_limbs([&alloc](std::span<const LimbT> llimbs, int) {
+        std::tuple<limb_t*, size_t, size_t, int> result{ nullptr, 0, 0, 1 };
+        size_t rsz = (llimbs.size() + 1) / 2;
+        if (!rsz) [[unlikely]] return result;
+        get<2>(result) = rsz;
+        get<0>(result) = alloc_traits_t::allocate(alloc, rsz);
+        NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&alloc, &result] { alloc_traits_t::deallocate(alloc, get<0>(result), get<2>(result)); });
+        get<1>(result) = limb_arithmetic::usqrtrem<limb_t>(llimbs.data(), llimbs.size(), get<0>(result), nullptr, std::allocator<limb_t>{}).first;
+        return result;
+    });
+}
+
 template <std::unsigned_integral LimbT, typename AllocatorT>
 requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
 [[nodiscard]] auto pow(basic_integer_view<LimbT> l, unsigned int n, AllocatorT&& alloc)
@@ -164,7 +229,7 @@ requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_
         }
         n >>= 1;
         if (!n) break;
-        auto [limbs, sz, rsz, sign] = limb_arithmetic::mul(base.decompose(), base.decompose(), alloc);
+        auto [limbs, sz, rsz, sign] = limb_arithmetic::sqr(base.decompose(), alloc);
         if (balloc) { alloc_traits_t::deallocate(alloc, const_cast<LimbT*>(base.data()), balloc); }
         base = basic_integer_view<LimbT>{ std::span{limbs, sz}, sign }; balloc = rsz;
     }
@@ -156,11 +156,12 @@ requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_
                     result = { nullptr, 0, 0, 1 };
                     return result;
                 }
-                llimbs = llimbs.first(llimbs.size() - 1);
-                rlimbs = rlimbs.first(llimbs.size() - 1);
                 last_l = llimbs.back();
                 last_r = rlimbs.back();
+                llimbs = llimbs.first(llimbs.size() - 1);
+                rlimbs = rlimbs.first(rlimbs.size() - 1);
             }
+            maxargsz = llimbs.size() + 1; // the equal high limbs cancel
             do_swap = last_l < last_r;
         }
 
@@ -488,6 +489,30 @@ LimbT usub(std::span<const LimbT> u, std::span<const LimbT> v, std::span<LimbT>
     }
 }
 
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
+[[nodiscard]] std::tuple<std::remove_cv_t<LimbT>*, size_t, size_t, int> mul(composition<LimbT> const& l, composition<LimbT> const& r, AllocatorT&& alloc);
+
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
+[[nodiscard]] std::tuple<std::remove_cv_t<LimbT>*, size_t, size_t, int> sqr(composition<LimbT> const& l, AllocatorT&& alloc)
+{
+    auto& [llimbs, lmask, lsign] = l;
+
+    if (llimbs.empty()) {
+        return { nullptr, 0, 0, 0 };
+    }
+    if (lmask != (std::numeric_limits<LimbT>::max)()) {
+        // the masked high limb is not addressable as a plain limb span, take the general path
+        return mul(l, l, std::forward<AllocatorT>(alloc));
+    }
+
+    std::tuple<LimbT*, size_t, size_t, int> result;
+    std::tie(get<0>(result), get<1>(result), get<2>(result)) = usqr<LimbT>(llimbs, std::move(alloc));
+    get<3>(result) = get<1>(result) ? 1 : 0;
+    return result;
+}
+
 template <std::unsigned_integral LimbT, typename AllocatorT>
 requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_t<AllocatorT>>::value_type>)
 [[nodiscard]] std::tuple<std::remove_cv_t<LimbT>*, size_t, size_t, int> mul(composition<LimbT> const& l, composition<LimbT> const& r, AllocatorT&& alloc)
@@ -513,6 +538,13 @@ requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_
             LimbT hl = llimbs.back() & lmask;
             LimbT hr = rlimbs.back() & rmask;
             auto [h, l] = arithmetic::umul1(hl, hr);
+            if (!l && !h) {
+                // an inplaced zero is a single zero limb, the product is not signed
+                get<0>(result) = nullptr;
+                get<1>(result) = get<2>(result) = 0;
+                get<3>(result) = 0;
+                return result;
+            }
             if (h) {
                 get<1>(result) = get<2>(result) = 2;
                 get<0>(result) = alloc_traits_t::allocate(alloc, 2);
@@ -556,6 +588,7 @@ requires(std::is_same_v<LimbT, typename std::allocator_traits<std::remove_cvref_
     while (get<1>(result) && !*(get<0>(result) + get<1>(result) - 1)) {
         --get<1>(result);
     }
+    if (!get<1>(result)) get<3>(result) = 1;
     return result;
 }
 
@@ -582,14 +615,4 @@ inline void ushift_left(std::span<const LimbT> u, size_t shift, std::span<LimbT>
 }
 
 
-
-template <std::unsigned_integral LimbT>
-auto sqrt_rem(std::span<const LimbT> m, std::span<LimbT> s) noexcept
-{
-    size_t l = (m.size() - 1) / 4;
-    if (!l) {
-        s[0] = numetron::arithmetic::sqrt<LimbT>(m[0]);
-    }
-}
-
 }
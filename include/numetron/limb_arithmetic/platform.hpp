@@ -7,13 +7,53 @@
 #if defined(NUMETRON_USE_ASM) && (defined(__x86_64__) || defined(_M_X64))
 
 #if defined(NUMETRON_PLATFORM_AUTODETECT)
-#include <mutex>
+#include "umul_basecase_ifma.hpp"
+#include "ubatch_mul_simd.hpp"
+
 typedef void (*detect_mul_basecase_type)(uint64_t*, const uint64_t*, size_t, const uint64_t*, size_t);
-inline std::once_flag mul_basecase_init_flag;
+typedef void (*sqr_basecase_type)(uint64_t*, const uint64_t*, size_t);
 extern "C" uint64_t numetron_detect_platform();
 extern "C" detect_mul_basecase_type detect_mul_basecase(uint64_t);
-inline void (*__mul_basecase_ptr)(uint64_t*, const uint64_t*, size_t, const uint64_t*, size_t) = nullptr;
-#define NUMETRON_mul_basecase __mul_basecase_ptr
+
+namespace numetron::limb_arithmetic {
+
+// The platform descriptor keeps the vendor, family and model in the low 32 bits and the feature flags above them.
+inline constexpr uint64_t platform_model_mask = 0xFFFFFFFF;
+inline constexpr uint64_t platform_feature_avx512ifma = uint64_t{ 1 } << 32;
+inline constexpr uint64_t platform_feature_avx2 = uint64_t{ 1 } << 33;
+
+// The assembly kernels picked for the running CPU, one entry per kernel; a null entry selects the portable code.
+// The IFMA kernels only cover the sizes that is_ifma_mul_applicable and is_ifma_sqr_applicable admit.
+struct platform_kernels
+{
+    detect_mul_basecase_type mul_basecase = nullptr;
+    detect_mul_basecase_type mul_basecase_ifma = nullptr;
+    sqr_basecase_type sqr_basecase_ifma = nullptr;
+    batch_mul_kernels batch_mul = {}; // indexed by the limb count - 1
+};
+
+inline platform_kernels resolve_platform_kernels() noexcept
+{
+    platform_kernels result;
+    const uint64_t platform_descriptor = numetron_detect_platform();
+    result.mul_basecase = detect_mul_basecase(platform_descriptor & platform_model_mask);
+    if (platform_descriptor & platform_feature_avx512ifma) {
+        result.mul_basecase_ifma = &umul_basecase_ifma;
+        result.sqr_basecase_ifma = &usqr_basecase_ifma;
+        result.batch_mul = batch_mul_ifma_kernels;
+    } else if (platform_descriptor & platform_feature_avx2) {
+        result.batch_mul = batch_mul_avx2_kernels;
+    }
+    return result;
+}
+
+// Filled by the dynamic initialization, so the hot paths load a pointer instead of checking a once_flag. The table is
+// zero-initialized before that, and a caller from another static initializer that runs first gets the portable code.
+inline platform_kernels kernel_table = resolve_platform_kernels();
+
+}
+
+#define NUMETRON_mul_basecase ::numetron::limb_arithmetic::kernel_table.mul_basecase
 #endif
 
 #if defined(NUMETRON_PLATFORM_K8)
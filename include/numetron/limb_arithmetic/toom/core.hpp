@@ -25,10 +25,16 @@ enum class toom_op : unsigned char
     inplace_sub,
     // dst <- src0 * imm
     mul_small,
+    // dst += src0 * imm
+    addmul_small,
+    // dst -= src0 * imm
+    submul_small,
     // dst <- src0 / imm, exact division is required (remainder must be 0)
     divexact_small,
     // dst <- src0 * src1
     mul_block,
+    // dst <- src0 * src0
+    sqr_block,
     // rb += src0 << (imm * chunk) limbs
     compose_shifted,
     // print dst for debugging (src0, src1 are ignored)
@@ -280,7 +286,8 @@ struct slot_builder
 template <size_t>
 inline constexpr bool always_false_v = false;
 
-template <size_t N, size_t M>
+// SquareV selects the squaring variant of a plan: only u is evaluated and v is never referenced.
+template <size_t N, size_t M, bool SquareV = false>
 struct toom_stage_traits
 {
     static_assert(always_false_v<N + M>, "Missing toom_stage_traits specialization for this (N,M)");
@@ -17,6 +17,14 @@
 
 #include "toom_2x2.hpp"
 #include "toom_3x3.hpp"
+#include "toom_sqr2.hpp"
+#include "toom_sqr3.hpp"
+#include "toom_4x4.hpp"
+#include "toom_6x6.hpp"
+#include "toom_8x8.hpp"
+#include "toom_3x2.hpp"
+#include "toom_4x2.hpp"
+#include "toom_4x3.hpp"
 
 #include "numetron/limb_arithmetic/toom/slot.hpp"
 
@@ -37,9 +45,9 @@ struct stage_memory_state
 {
     LimbT* slab = nullptr;
     toom_slot<LimbT>* slots = nullptr;
-    size_t slab_len:16 = 0;
-    size_t slab_alloc_len:16 = 0;
-    size_t slab_owned:1 = 0;
+    size_t slab_len = 0;
+    size_t slab_alloc_len = 0;
+    bool slab_owned = false;
 };
 
 template <auto LayoutV, toom_mem_kind KindV>
@@ -110,7 +118,7 @@ inline size_t eval_size_expr_ct(toom_size_eval_context const& c)
         } else if constexpr (op == toom_size_expr_op::max2) {
             return (std::max)(eval_size_expr_ct<ExpressionsV, e.a.raw>(c), eval_size_expr_ct<ExpressionsV, e.b.raw>(c));
         } else {
-            static_assert(false, "Unsupported toom size expression op");
+            static_assert(always_false_v<ExprId>, "Unsupported toom size expression op");
         }
     }
 }
@@ -326,6 +334,10 @@ inline void run_toom_op(
         auto& dst = resolve_ref_write<op.dst, LimbT>(mem);
         auto const s0 = resolve_ref_read<op.src0, LimbT, TraitsT::N, TraitsT::M>(mem, u, v, size_ctx.chunk);
         slot_mul_small(dst, s0, static_cast<LimbT>(op.imm));
+    } else if constexpr (op.op == toom_op::addmul_small || op.op == toom_op::submul_small) {
+        auto& dst = resolve_ref_write<op.dst, LimbT>(mem);
+        auto const s0 = resolve_ref_read<op.src0, LimbT, TraitsT::N, TraitsT::M>(mem, u, v, size_ctx.chunk);
+        slot_addmul_small(dst, s0, static_cast<LimbT>(op.imm), op.op == toom_op::addmul_small ? 1 : -1);
     } else if constexpr (op.op == toom_op::divexact_small) {
         auto& dst = resolve_ref_write<op.dst, LimbT>(mem);
         auto const s0 = resolve_ref_read<op.src0, LimbT, TraitsT::N, TraitsT::M>(mem, u, v, size_ctx.chunk);
@@ -335,6 +347,10 @@ inline void run_toom_op(
         auto const s1 = resolve_ref_read<op.src1, LimbT, TraitsT::N, TraitsT::M>(mem, u, v, size_ctx.chunk);
         auto& dst = resolve_ref_write<op.dst, LimbT>(mem);
         slot_mul_dispatch(dst, s0, s1, scratch_alloc);
+    } else if constexpr (op.op == toom_op::sqr_block) {
+        auto const s0 = resolve_ref_read<op.src0, LimbT, TraitsT::N, TraitsT::M>(mem, u, v, size_ctx.chunk);
+        auto& dst = resolve_ref_write<op.dst, LimbT>(mem);
+        slot_sqr_dispatch(dst, s0, scratch_alloc);
     } else if constexpr (op.op == toom_op::compose_shifted) {
         auto const s0 = resolve_ref_read<op.src0, LimbT, TraitsT::N, TraitsT::M>(mem, u, v, size_ctx.chunk);
         slot_add_shifted_to_result(rb, rsz, s0, static_cast<size_t>(op.imm) * size_ctx.chunk);
@@ -346,7 +362,7 @@ inline void run_toom_op(
     }
 }
 
-template <std::unsigned_integral LimbT, size_t N, size_t M, typename ScratchAllocatorT, size_t... Is>
+template <std::unsigned_integral LimbT, typename TraitsT, typename ScratchAllocatorT, size_t... Is>
 inline void run_toom_stage(
     std::span<const LimbT> u,
     std::span<const LimbT> v,
@@ -356,6 +372,8 @@ inline void run_toom_stage(
     ScratchAllocatorT scratch_alloc,
     std::index_sequence<Is...>)
 {
+    constexpr size_t N = TraitsT::N;
+    constexpr size_t M = TraitsT::M;
     const size_t u_hi = u.size() - (N - 1) * chunk;
     const toom_size_eval_context size_ctx{
         u.size(),
@@ -366,7 +384,7 @@ inline void run_toom_stage(
         (std::max)(chunk, u_hi),
     };
 
-    using traits_t = toom_stage_traits<N, M>;
+    using traits_t = TraitsT;
     static_assert(has_unique_slot_vars<traits_t::slot_layout>(),
         "toom slot ids must be unique across slot_layout entries");
     constexpr size_t tmp_slot_count = required_slot_count<traits_t::slot_layout, toom_mem_kind::tmp>();
@@ -441,7 +459,7 @@ struct toom_engine
             NUMETRON_ASSERT(chunk > 0);
 
             std::memset(rb, 0, alloc_sz * sizeof(LimbT));
-            run_toom_stage<LimbT, N, M>(u, v, rb, alloc_sz, chunk, alloc,
+            run_toom_stage<LimbT, toom_stage_traits<N, M>>(u, v, rb, alloc_sz, chunk, alloc,
                 std::make_index_sequence<toom_stage_traits<N, M>::plan.size()>{});
             re = rb + alloc_sz;
 
@@ -471,10 +489,40 @@ struct toom_engine
         NUMETRON_ASSERT(chunk > 0);
 
         std::memset(rb, 0, r_sz * sizeof(LimbT));
-        run_toom_stage<LimbT, N, M>(std::span{u, un}, std::span{v, vn}, rb, r_sz, chunk, alloc,
+        run_toom_stage<LimbT, toom_stage_traits<N, M>>(std::span{u, un}, std::span{v, vn}, rb, r_sz, chunk, alloc,
             std::make_index_sequence<toom_stage_traits<N, M>::plan.size()>{});
         return rb + r_sz;
     }
 };
 
+// Squaring counterpart of toom_engine<N, N>: runs toom_stage_traits<N, N, true>,
+// the plan evaluates u only and every pointwise product is a square.
+template <size_t N>
+struct toom_sqr_engine
+{
+    static_assert(N > 1, "toom_sqr_engine requires N > 1");
+
+    template <std::unsigned_integral LimbT, typename AllocatorT>
+    static LimbT* usqr(
+        const LimbT* u, size_t un,
+        LimbT* rb,
+        AllocatorT alloc)
+    {
+        using namespace toom_runtime_detail;
+        using traits_t = toom_stage_traits<N, N, true>;
+
+        NUMETRON_ASSERT(un > 0);
+
+        const size_t r_sz = 2 * un;
+
+        const size_t chunk = (un + (N - 1)) / N;
+        NUMETRON_ASSERT(chunk > 0);
+
+        std::memset(rb, 0, r_sz * sizeof(LimbT));
+        run_toom_stage<LimbT, traits_t>(std::span{u, un}, std::span{u, un}, rb, r_sz, chunk, alloc,
+            std::make_index_sequence<traits_t::plan.size()>{});
+        return rb + r_sz;
+    }
+};
+
 } // namespace numetron::limb_arithmetic
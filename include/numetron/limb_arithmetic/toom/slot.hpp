@@ -9,6 +9,9 @@
 #include "numetron/detail/assert.hpp"
 
 //#include "numetron/limb_arithmetic/umul_karatsuba.hpp"   // detail::uabs_diff, detail::umul_dispatch
+#include "numetron/limb_arithmetic/uadd.hpp"
+#include "numetron/limb_arithmetic/usub.hpp"
+#include "numetron/limb_arithmetic/umul1.hpp"
 #include "numetron/limb_arithmetic/udivby1.hpp"
 #include "numetron/detail/stack_allocator.hpp"
 
@@ -21,6 +24,12 @@ LimbT* umul_dispatch(
     LimbT* rb,
     AllocatorT alloc);
 
+template <std::unsigned_integral LimbT, typename AllocatorT>
+LimbT* usqr_dispatch(
+    const LimbT* u, size_t un,
+    LimbT* rb,
+    AllocatorT alloc);
+
 }
 
 namespace numetron::limb_arithmetic::toom_runtime_detail {
@@ -188,6 +197,25 @@ inline void slot_mul_dispatch(toom_slot<LimbT>& dst, toom_slot<LimbT> const& a,
     dst.sign = a.sign * b.sign * !!result_len;
 }
 
+template <std::unsigned_integral LimbT, typename ScratchAllocatorT>
+inline void slot_sqr_dispatch(toom_slot<LimbT>& dst, toom_slot<LimbT> const& a, ScratchAllocatorT scratch_alloc)
+{
+    if (!a.sign) {
+        std::memset(dst.ptr, 0, dst.len * sizeof(LimbT));
+        dst.sign = 0;
+        return;
+    }
+    NUMETRON_ASSERT(dst.cap >= 2 * a.len);
+    LimbT* re = usqr_dispatch(a.ptr, a.len, dst.ptr, scratch_alloc);
+    size_t result_len = static_cast<size_t>(re - dst.ptr);
+    if (dst.len > result_len) {
+        std::memset(dst.ptr + result_len, 0, (dst.len - result_len) * sizeof(LimbT));
+    } else {
+        dst.len = result_len;
+    }
+    dst.sign = !!result_len;
+}
+
 ////////////
 
 template <std::unsigned_integral LimbT>
@@ -212,6 +240,58 @@ inline void slot_mul_small(toom_slot<LimbT>& dst, toom_slot<LimbT> const& a, Lim
     slot_trim(dst);
 }
 
+// dst += op_sign * a * k in a single pass over a; dst and a must not overlap
+template <std::unsigned_integral LimbT>
+inline void slot_addmul_small(toom_slot<LimbT>& dst, toom_slot<LimbT> a, LimbT k, int op_sign)
+{
+    slot_trim(a);
+    if (!a.sign || k == 0) return;
+    const int term_sign = a.sign * op_sign;
+    slot_trim(dst);
+    if (!dst.sign) {
+        slot_mul_small(dst, a, k);
+        dst.sign = term_sign;
+        return;
+    }
+
+    NUMETRON_ASSERT(dst.cap >= a.len + 1);
+    if (dst.len < a.len) {
+        std::memset(dst.ptr + dst.len, 0, (a.len - dst.len) * sizeof(LimbT));
+        dst.len = a.len;
+    }
+    LimbT* r = dst.ptr;
+    if (dst.sign == term_sign) {
+        LimbT c = umul1_add<LimbT>(a.ptr, a.ptr + a.len, k, r);
+        c = uadd_limb(r, dst.ptr + dst.len, c);
+        if (c) {
+            NUMETRON_ASSERT(dst.cap >= dst.len + 1);
+            dst.ptr[dst.len++] = c;
+        }
+        return;
+    }
+
+    LimbT c = umul1_sub<LimbT>(a.ptr, a.ptr + a.len, k, r);
+    if (r != dst.ptr + dst.len) {
+        c = usub_limb(r, dst.ptr + dst.len, c);
+    }
+    if (c) {
+        // the stored value is dst - c * B^len: negate it, |result| = c * B^len - dst
+        unsigned char zero = 1;
+        for (size_t i = 0; i < dst.len; ++i) {
+            LimbT x = dst.ptr[i];
+            dst.ptr[i] = static_cast<LimbT>(~x + zero);
+            zero &= (x == 0);
+        }
+        LimbT h = static_cast<LimbT>(c - 1 + zero);
+        if (h) {
+            NUMETRON_ASSERT(dst.cap >= dst.len + 1);
+            dst.ptr[dst.len++] = h;
+        }
+        dst.sign = -dst.sign;
+    }
+    slot_trim(dst);
+}
+
 template <std::unsigned_integral LimbT>
 inline void slot_divexact_small(toom_slot<LimbT>& dst, toom_slot<LimbT> const& a, LimbT d)
 {
@@ -220,8 +300,7 @@ inline void slot_divexact_small(toom_slot<LimbT>& dst, toom_slot<LimbT> const& a
         return;
     }
     NUMETRON_ASSERT(dst.cap >= a.len);
-    LimbT rem = udivby1<LimbT>(std::span<const LimbT>{a.ptr, a.len}, d, std::span<LimbT>{dst.ptr, a.len});
-    NUMETRON_ASSERT(rem == 0);
+    udivexact_by1<LimbT>(std::span<const LimbT>{a.ptr, a.len}, d, std::span<LimbT>{dst.ptr, a.len});
     dst.len = a.len;
     dst.sign = a.sign;
     slot_trim(dst);
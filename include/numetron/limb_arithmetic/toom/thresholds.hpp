@@ -4,6 +4,12 @@
 
 #pragma once
 
+// a header written by numetron_tune for the target machine, its values take precedence over the defaults
+// here and in the other headers that are reached through this one
+#ifdef NUMETRON_TUNED_THRESHOLDS_HEADER
+#   include NUMETRON_TUNED_THRESHOLDS_HEADER
+#endif
+
 #ifndef NUMETRON_KARATSUBA_THRESHOLD
 #   define NUMETRON_KARATSUBA_THRESHOLD 70
 #endif
@@ -12,4 +18,48 @@
 #   define NUMETRON_TOOM3_THRESHOLD 160
 #endif
 
+#ifndef NUMETRON_TOOM4_THRESHOLD
+#   define NUMETRON_TOOM4_THRESHOLD 1000
+#endif
+
+#ifndef NUMETRON_TOOM6H_THRESHOLD
+#   define NUMETRON_TOOM6H_THRESHOLD 2500
+#endif
+
+#ifndef NUMETRON_TOOM8_THRESHOLD
+#   define NUMETRON_TOOM8_THRESHOLD 6000
+#endif
+
+#ifndef NUMETRON_TOOM32_THRESHOLD
+#   define NUMETRON_TOOM32_THRESHOLD 70
+#endif
+
+#ifndef NUMETRON_TOOM42_THRESHOLD
+#   define NUMETRON_TOOM42_THRESHOLD 160
+#endif
+
+#ifndef NUMETRON_TOOM43_THRESHOLD
+#   define NUMETRON_TOOM43_THRESHOLD 160
+#endif
+
+#ifndef NUMETRON_SQR_KARATSUBA_THRESHOLD
+#   define NUMETRON_SQR_KARATSUBA_THRESHOLD 120
+#endif
+
+#ifndef NUMETRON_SQR_TOOM3_THRESHOLD
+#   define NUMETRON_SQR_TOOM3_THRESHOLD 300
+#endif
+
+#ifndef NUMETRON_SQR_TOOM4_THRESHOLD
+#   define NUMETRON_SQR_TOOM4_THRESHOLD 1500
+#endif
+
+#ifndef NUMETRON_SQR_TOOM6_THRESHOLD
+#   define NUMETRON_SQR_TOOM6_THRESHOLD 4000
+#endif
+
+#ifndef NUMETRON_SQR_TOOM8_THRESHOLD
+#   define NUMETRON_SQR_TOOM8_THRESHOLD 7000
+#endif
+
 //#define NUMETRON_EXPLICIT_KARATSUBA
\ No newline at end of file
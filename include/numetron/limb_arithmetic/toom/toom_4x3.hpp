@@ -0,0 +1,30 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include "toom_points.hpp"
+
+namespace numetron::limb_arithmetic {
+
+namespace toom_runtime_detail {
+
+// Toom-4x3: u is split into 4 pieces and v into 3, for un around 4/3 * vn.
+// The product is evaluated at 0, 1, -1, 2, -2 and inf.
+static constexpr auto toom43 = make_toom_points<4, 3>();
+
+template <>
+struct toom_stage_traits<4, 3>
+{
+    static constexpr auto const& plan              = toom43.plan;
+    static constexpr auto const& size_exprs        = toom43.exprs;
+    static constexpr auto const& slot_layout       = toom43.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom43.slab_expr;
+    static constexpr size_t N = 4;
+    static constexpr size_t M = 3;
+};
+
+} // namespace toom_runtime_detail
+
+} // namespace numetron::limb_arithmetic
@@ -0,0 +1,43 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include "toom_points.hpp"
+
+namespace numetron::limb_arithmetic {
+
+namespace toom_runtime_detail {
+
+// Toom-4: u and v are split into 4 pieces, the product is evaluated at 0, 1, -1, 2, -2, 3 and inf.
+static constexpr auto toom4 = make_toom_points<4, 4>();
+
+template <>
+struct toom_stage_traits<4, 4>
+{
+    static constexpr auto const& plan              = toom4.plan;
+    static constexpr auto const& size_exprs        = toom4.exprs;
+    static constexpr auto const& slot_layout       = toom4.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom4.slab_expr;
+    static constexpr size_t N = 4;
+    static constexpr size_t M = 4;
+};
+
+// Toom-4 squaring.
+static constexpr auto toom_sqr4 = make_toom_points<4, 4, true>();
+
+template <>
+struct toom_stage_traits<4, 4, true>
+{
+    static constexpr auto const& plan              = toom_sqr4.plan;
+    static constexpr auto const& size_exprs        = toom_sqr4.exprs;
+    static constexpr auto const& slot_layout       = toom_sqr4.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom_sqr4.slab_expr;
+    static constexpr size_t N = 4;
+    static constexpr size_t M = 4;
+};
+
+} // namespace toom_runtime_detail
+
+} // namespace numetron::limb_arithmetic
@@ -0,0 +1,57 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include "toom_points.hpp"
+
+namespace numetron::limb_arithmetic {
+
+namespace toom_runtime_detail {
+
+// Toom-6.5: v is split into 6 pieces and u into 6 or 7, whichever keeps the top piece of u within a chunk.
+// The 6 x 6 product is evaluated at 0, +-1, .., +-4, 5 and inf, the 7 x 6 product at 0, +-1, .., +-5 and inf.
+static constexpr auto toom6 = make_toom_points<6, 6>();
+
+template <>
+struct toom_stage_traits<6, 6>
+{
+    static constexpr auto const& plan              = toom6.plan;
+    static constexpr auto const& size_exprs        = toom6.exprs;
+    static constexpr auto const& slot_layout       = toom6.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom6.slab_expr;
+    static constexpr size_t N = 6;
+    static constexpr size_t M = 6;
+};
+
+static constexpr auto toom6h = make_toom_points<7, 6>();
+
+template <>
+struct toom_stage_traits<7, 6>
+{
+    static constexpr auto const& plan              = toom6h.plan;
+    static constexpr auto const& size_exprs        = toom6h.exprs;
+    static constexpr auto const& slot_layout       = toom6h.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom6h.slab_expr;
+    static constexpr size_t N = 7;
+    static constexpr size_t M = 6;
+};
+
+// Toom-6 squaring.
+static constexpr auto toom_sqr6 = make_toom_points<6, 6, true>();
+
+template <>
+struct toom_stage_traits<6, 6, true>
+{
+    static constexpr auto const& plan              = toom_sqr6.plan;
+    static constexpr auto const& size_exprs        = toom_sqr6.exprs;
+    static constexpr auto const& slot_layout       = toom_sqr6.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom_sqr6.slab_expr;
+    static constexpr size_t N = 6;
+    static constexpr size_t M = 6;
+};
+
+} // namespace toom_runtime_detail
+
+} // namespace numetron::limb_arithmetic
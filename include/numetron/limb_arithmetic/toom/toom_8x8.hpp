@@ -0,0 +1,43 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include "toom_points.hpp"
+
+namespace numetron::limb_arithmetic {
+
+namespace toom_runtime_detail {
+
+// Toom-8: u and v are split into 8 pieces, the product is evaluated at 0, +-1, .., +-6, 7 and inf.
+static constexpr auto toom8 = make_toom_points<8, 8>();
+
+template <>
+struct toom_stage_traits<8, 8>
+{
+    static constexpr auto const& plan              = toom8.plan;
+    static constexpr auto const& size_exprs        = toom8.exprs;
+    static constexpr auto const& slot_layout       = toom8.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom8.slab_expr;
+    static constexpr size_t N = 8;
+    static constexpr size_t M = 8;
+};
+
+// Toom-8 squaring.
+static constexpr auto toom_sqr8 = make_toom_points<8, 8, true>();
+
+template <>
+struct toom_stage_traits<8, 8, true>
+{
+    static constexpr auto const& plan              = toom_sqr8.plan;
+    static constexpr auto const& size_exprs        = toom_sqr8.exprs;
+    static constexpr auto const& slot_layout       = toom_sqr8.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom_sqr8.slab_expr;
+    static constexpr size_t N = 8;
+    static constexpr size_t M = 8;
+};
+
+} // namespace toom_runtime_detail
+
+} // namespace numetron::limb_arithmetic
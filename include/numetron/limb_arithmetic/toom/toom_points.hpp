@@ -0,0 +1,277 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <numeric>
+#include <algorithm>
+
+#include "core.hpp"
+
+namespace numetron::limb_arithmetic {
+
+namespace toom_runtime_detail {
+
+// Plan generator for the higher-order Toom variants (Toom-4 and up).
+// Writing these plans by hand the way toom_3x3.hpp does is impractical: Toom-8 needs 15 evaluation
+// points and several hundred interpolation steps. The generator emits the same kind of plan
+// (toom_instr over slots registered by slot_builder, sizes built by expr_builder) for an N x M split
+// evaluated at the D = N + M - 2 finite points 0, 1, -1, 2, -2, ... and at infinity.
+//
+//   Evaluation    : A(x), A(-x) are computed together from the even and odd parts of A,
+//                   each by Horner's rule in x^2.
+//   Products      : W_i = A(x_i) * B(x_i), W_0 = u0 * v0 goes straight to rb, W_D = u_{N-1} * v_{M-1}.
+//   Interpolation : in-place Newton divided differences over W_0..W_{D-1}; all of them are exact
+//                   because the points are integers. The Newton form (with r_D = W_D as its leading
+//                   coefficient) is then expanded to monomial coefficients in place.
+//   Compose       : rb += W_i << (i * chunk), i = 1..D.
+//
+// Capacity analysis: every value is bounded by S * min(N, M) * B^(d_buf_n + chunk), where the
+// factor S is tracked while the interpolation is emitted. Margins are counted in 8-bit limbs,
+// so the plan is valid for every LimbT.
+template <size_t N, size_t M, bool SquareV>
+struct toom_points_generator
+{
+    static_assert(N >= 2 && M >= 2 && N >= M, "toom_points_generator requires N >= M >= 2");
+    static_assert(!SquareV || N == M, "squaring plans require N == M");
+
+    static constexpr size_t D = N + M - 2;
+
+    expr_builder b;
+    slot_builder sb;
+    std::vector<toom_instr> plan;
+    expr_handle slab{};
+
+    // x_0 = 0, x_{2k-1} = k, x_{2k} = -k
+    static consteval int point(size_t i)
+    {
+        return i == 0 ? 0 : ((i & 1) ? static_cast<int>((i + 1) / 2) : -static_cast<int>(i / 2));
+    }
+
+    static consteval unsigned short imm(long long k)
+    {
+        if (k <= 0 || k > 0xFFFF) throw "toom_points_generator: immediate is out of range";
+        return static_cast<unsigned short>(k);
+    }
+
+    // number of extra 8-bit limbs needed to hold a value scaled by s
+    static consteval size_t margin_limbs(double s)
+    {
+        size_t bits = 0;
+        for (; s >= 1.0; s /= 2.0) ++bits;
+        return (bits + 7) / 8 + 1;
+    }
+
+    static consteval double eval_bound(size_t parts, unsigned int x)
+    {
+        double r = 0.0, p = 1.0;
+        for (size_t i = 0; i < parts; ++i, p *= x) r += p;
+        return r;
+    }
+
+    // registers the next tmp slot right after the previous one, slab is the running total
+    consteval toom_ref next_tmp(expr_handle cap)
+    {
+        toom_ref r = sb.tmp(slab, cap);
+        slab = b.add(slab, cap);
+        return r;
+    }
+
+    consteval void emit(toom_op op, toom_ref dst, toom_ref src0 = {}, toom_ref src1 = {}, unsigned short k = 0)
+    {
+        plan.push_back(toom_instr{ op, dst, src0, src1, k });
+    }
+
+    // dst <- sum_j part(first + j * step) * s^j over the parts [first, parts), by Horner's rule
+    consteval void emit_horner(toom_ref dst, toom_ref (*part)(unsigned short), size_t parts, size_t first, size_t step, unsigned int s)
+    {
+        size_t top = first + ((parts - 1 - first) / step) * step;
+        if (top == first) {
+            emit(toom_op::copy, dst, part(static_cast<unsigned short>(top)));
+            return;
+        }
+        if (s == 1) {
+            emit(toom_op::add, dst, part(static_cast<unsigned short>(top)), part(static_cast<unsigned short>(top - step)));
+        } else {
+            emit(toom_op::mul_small, dst, part(static_cast<unsigned short>(top)), {}, imm(s));
+            emit(toom_op::add, dst, dst, part(static_cast<unsigned short>(top - step)));
+        }
+        for (size_t i = top - step; i != first; ) {
+            i -= step;
+            if (s != 1) emit(toom_op::mul_small, dst, dst, {}, imm(s));
+            emit(toom_op::add, dst, dst, part(static_cast<unsigned short>(i)));
+        }
+    }
+
+    // (P, M) <- (E(x) + O(x), E(x) - O(x)) if paired, otherwise P <- A(x)
+    consteval void emit_eval(toom_ref P, toom_ref Mn, toom_ref T, toom_ref (*part)(unsigned short), size_t parts, unsigned int x, bool paired)
+    {
+        if (!paired) {
+            emit_horner(P, part, parts, 0, 1, x);
+            return;
+        }
+        emit_horner(P, part, parts, 0, 2, x * x);
+        emit_horner(T, part, parts, 1, 2, x * x);
+        if (x != 1) emit(toom_op::mul_small, T, T, {}, imm(x));
+        emit(toom_op::sub, Mn, P, T);
+        emit(toom_op::add, P, P, T);
+    }
+
+    consteval void emit_product(toom_ref dst, toom_ref a, toom_ref bv)
+    {
+        if constexpr (SquareV) emit(toom_op::sqr_block, dst, a);
+        else emit(toom_op::mul_block, dst, a, bv);
+    }
+
+    // Interpolation keeps W_i scaled by a known factor instead of dividing at every step: the exact
+    // division is the most expensive linear pass, while a rescale is a cheap mul_small.
+    // W_i holds value_i * scale[i], |W_i| <= bound[i] * min(N, M) * B^(d_buf_n + chunk).
+    struct interp_step { toom_op op; size_t dst, src0, src1; unsigned short k = 0; };
+    static constexpr size_t max_scale = 0xFFFF;
+
+    std::vector<interp_step> steps;
+    std::array<size_t, D + 1> scale{};
+    std::array<double, D + 1> bound{};
+    double bound_max = 0.0;
+
+    consteval void rescale(size_t i, size_t f)
+    {
+        if (f == 1) return;
+        if (i == 0) throw "toom_points_generator: W_0 lives in rb and cannot be rescaled";
+        steps.push_back(interp_step{ toom_op::mul_small, i, i, 0, imm(static_cast<long long>(f)) });
+        scale[i] *= f;
+        bound[i] *= static_cast<double>(f);
+        bound_max = (std::max)(bound_max, bound[i]);
+    }
+
+    consteval void unscale(size_t i)
+    {
+        if (scale[i] == 1) return;
+        steps.push_back(interp_step{ toom_op::divexact_small, i, i, 0, imm(static_cast<long long>(scale[i])) });
+        bound[i] /= static_cast<double>(scale[i]);
+        scale[i] = 1;
+    }
+
+    // brings W_i and W_j to a common scale
+    consteval void align(size_t i, size_t j)
+    {
+        if (std::lcm(scale[i], scale[j]) > max_scale) unscale(scale[i] >= scale[j] ? i : j);
+        if (std::lcm(scale[i], scale[j]) > max_scale) unscale(scale[i] >= scale[j] ? i : j);
+        const size_t l = std::lcm(scale[i], scale[j]);
+        rescale(i, l / scale[i]);
+        rescale(j, l / scale[j]);
+    }
+
+    consteval void build()
+    {
+        constexpr unsigned int xmax = static_cast<unsigned int>(D / 2);
+        slab = b.c(0);
+
+        // Interpolation is planned first: the capacities depend on the bounds collected here.
+        for (size_t i = 0; i <= D; ++i) {
+            scale[i] = 1;
+            bound[i] = i == D ? 1.0 : eval_bound(D + 1, static_cast<unsigned int>(point(i) < 0 ? -point(i) : point(i)));
+            bound_max = (std::max)(bound_max, bound[i]);
+        }
+
+        // Newton divided differences: W_i <- (W_i - W_{i-1}) / (x_i - x_{i-k})
+        for (size_t k = 1; k < D; ++k) {
+            for (size_t i = D - 1; i >= k; --i) {
+                const int dx = point(i) - point(i - k);
+                align(i, i - 1);
+                if (dx > 0) steps.push_back(interp_step{ toom_op::sub, i, i, i - 1 });
+                else steps.push_back(interp_step{ toom_op::sub, i, i - 1, i });
+                bound[i] += bound[i - 1];
+                bound_max = (std::max)(bound_max, bound[i]);
+                const size_t adx = static_cast<size_t>(dx < 0 ? -dx : dx);
+                if (scale[i] * adx > max_scale) unscale(i);
+                scale[i] *= adx;
+            }
+        }
+
+        // expand c_0 + (x - x_0)(c_1 + (x - x_1)(... + (x - x_{D-1}) r_D)) to monomials, x_0 = 0 is skipped:
+        // W_j <- W_j - x_k * W_{j+1}, j = k..D-1
+        for (size_t k = D - 1; k > 0; --k) {
+            const int x = point(k);
+            const unsigned short ax = imm(x < 0 ? -x : x);
+            for (size_t j = k; j < D; ++j) {
+                align(j, j + 1);
+                if (ax == 1) steps.push_back(interp_step{ x > 0 ? toom_op::sub : toom_op::add, j, j, j + 1 });
+                else steps.push_back(interp_step{ x > 0 ? toom_op::submul_small : toom_op::addmul_small, j, j + 1, 0, ax });
+                bound[j] += bound[j + 1] * ax;
+                bound_max = (std::max)(bound_max, bound[j]);
+            }
+        }
+        for (size_t j = 1; j <= D; ++j) unscale(j);
+
+        auto c = b.v(toom_size_var::chunk);
+        auto dn = b.v(toom_size_var::d_buf_n);
+
+        const size_t ea_m = margin_limbs(eval_bound(N, xmax));
+        const size_t eb_m = margin_limbs(eval_bound(M, xmax));
+        const size_t r_m = margin_limbs(bound_max * static_cast<double>(M));
+
+        auto cap_ea = b.add(dn, b.c(ea_m));
+        auto cap_eb = b.add(c, b.c(eb_m));
+        auto cap_w  = b.add(b.add(dn, c), b.c((std::max)(ea_m + eb_m, r_m)));
+
+
+        auto EP = next_tmp(cap_ea);
+        auto EM = next_tmp(cap_ea);
+        auto ET = next_tmp(cap_ea);
+        auto FP = SquareV ? EP : next_tmp(cap_eb);
+        auto FM = SquareV ? EM : next_tmp(cap_eb);
+        std::array<toom_ref, D + 1> W{};
+        W[0] = sb.rb(b.c(0), b.mul(c, 2));
+        for (size_t i = 1; i <= D; ++i) W[i] = next_tmp(cap_w);
+
+        auto u = slot_builder::u;
+        auto v = slot_builder::v;
+
+        // Evaluate and multiply point by point, so that only one pair of evaluations is alive at a time.
+        emit_product(W[0], u(0), v(0));
+        for (size_t i = 1; i < D; i += 2) {
+            unsigned int x = static_cast<unsigned int>(point(i));
+            bool paired = i + 1 < D;
+            emit_eval(EP, EM, ET, u, N, x, paired);
+            if constexpr (!SquareV) emit_eval(FP, FM, ET, v, M, x, paired);
+            emit_product(W[i], EP, FP);
+            if (paired) emit_product(W[i + 1], EM, FM);
+        }
+        emit_product(W[D], u(N - 1), v(M - 1));
+
+        // Interpolation.
+        for (interp_step const& st : steps) {
+            if (st.k) emit(st.op, W[st.dst], W[st.src0], {}, st.k);
+            else emit(st.op, W[st.dst], W[st.src0], W[st.src1]);
+        }
+
+        // Compose to result rb.
+        for (size_t i = 1; i <= D; ++i) {
+            emit(toom_op::compose_shifted, W[0], W[i], {}, static_cast<unsigned short>(i));
+        }
+    }
+};
+
+template <size_t N, size_t M, bool SquareV>
+consteval size_t toom_points_plan_size()
+{
+    toom_points_generator<N, M, SquareV> g;
+    g.build();
+    return g.plan.size();
+}
+
+template <size_t N, size_t M, bool SquareV = false>
+consteval auto make_toom_points()
+{
+    toom_points_generator<N, M, SquareV> g;
+    g.build();
+    std::array<toom_instr, toom_points_plan_size<N, M, SquareV>()> plan{};
+    std::copy(g.plan.begin(), g.plan.end(), plan.begin());
+    return toom_full_spec{ g.b.finish(g.slab), g.sb.finish(), g.slab, plan };
+}
+
+} // namespace toom_runtime_detail
+
+} // namespace numetron::limb_arithmetic
@@ -0,0 +1,78 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include "core.hpp"
+
+namespace numetron::limb_arithmetic {
+
+namespace toom_runtime_detail {
+
+consteval auto make_toom_sqr2()
+{
+    // Karatsuba squaring: u^2 = u0^2 + (u0^2 + u1^2 - (u0 - u1)^2) * B^n2 + u1^2 * B^(2n2).
+    // v is never referenced, so only one difference is evaluated and all three products are squares.
+    expr_builder b;
+
+    auto n2                  = b.v(toom_size_var::chunk);
+    auto two_n2              = b.mul(n2, 2);
+    auto three_n2            = b.mul(n2, 3);
+    auto slab                = b.mul(n2, 5);
+    auto two_u_hi            = b.mul(b.v(toom_size_var::u_hi), 2);
+    auto two_un_minus_n2     = b.sub(b.mul(b.v(toom_size_var::un), 2), n2);
+
+    // Scratch map:
+    //   [0 .. n2)                    -> d_u = |u0 - u1|
+    //   [n2 .. 3n2)                  -> TC0 (copy of c0)
+    //   [3n2 .. 5n2)                 -> TC2 = d_u^2
+    // Result-buffer views:
+    //   rb[0 .. 2n2)                 -> C0 = u0^2
+    //   rb[2n2 .. 2n2 + 2u_hi)       -> C1 = u1^2
+    //   rb[n2 .. 2un)                -> RM (middle accumulation window)
+    slot_builder sb;
+    auto d_u = sb.tmp(b.c(0),   n2);
+    auto TC0 = sb.tmp(n2,       two_n2);
+    auto TC2 = sb.tmp(three_n2, two_n2);
+    auto C0  = sb.rb (b.c(0),   two_n2);
+    auto C1  = sb.rb (two_n2,   two_u_hi);
+    auto RM  = sb.rb (n2,       two_un_minus_n2);
+
+    auto u = slot_builder::u;
+
+    std::array plan = {
+        // Pointwise squares at x=0 and x=inf.
+        toom_instr{ toom_op::sqr_block,   C0,  u(0)       },
+        toom_instr{ toom_op::sqr_block,   C1,  u(1)       },
+
+        // Evaluate at x=-1: (u0-u1)^2.
+        toom_instr{ toom_op::sub,         d_u, u(0), u(1) },
+        toom_instr{ toom_op::sqr_block,   TC2, d_u        },
+
+        // Middle accumulation: RM += C1 + copy(C0) - TC2.
+        toom_instr{ toom_op::copy,        TC0, C0         },
+        toom_instr{ toom_op::inplace_add, RM,  C1         },
+        toom_instr{ toom_op::inplace_add, RM,  TC0        },
+        toom_instr{ toom_op::inplace_sub, RM,  TC2        },
+    };
+
+    return toom_full_spec{ b.finish(slab), sb.finish(), slab, plan };
+}
+
+static constexpr auto toom_sqr2 = make_toom_sqr2();
+
+template <>
+struct toom_stage_traits<2, 2, true>
+{
+    static constexpr auto const& plan              = toom_sqr2.plan;
+    static constexpr auto const& size_exprs        = toom_sqr2.exprs;
+    static constexpr auto const& slot_layout       = toom_sqr2.slot_layout;
+    static constexpr expr_handle slab_size_expr_id = toom_sqr2.slab_expr;
+    static constexpr size_t N = 2;
+    static constexpr size_t M = 2;
+};
+
+} // namespace toom_runtime_detail
+
+} // namespace numetron::limb_arithmetic
@@ -0,0 +1,61 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <memory>
+
+#include "numetron/limb_arithmetic.hpp"
+#include "umul1.hpp"
+#include "umul_basecase.hpp"
+
+#ifndef NUMETRON_BATCH_MUL_MAX_LIMBS
+#   define NUMETRON_BATCH_MUL_MAX_LIMBS 8
+#endif
+
+namespace numetron::limb_arithmetic {
+
+// a[k] * b[k] -> r[k] for the count numbers of limbs limbs each, k < count, stored as structures of arrays:
+// the limb i of the k-th number is a[i * count + k], the limb i of its product is r[i * count + k], i < 2 * limbs;
+// the numbers of up to NUMETRON_BATCH_MUL_MAX_LIMBS limbs go through the lane-parallel kernels of the platform
+// prereqs: limbs > 0, r does not overlap a and b
+template <std::unsigned_integral LimbT>
+void ubatch_mul(LimbT const* a, LimbT const* b, size_t limbs, size_t count, LimbT* r)
+{
+    assert(limbs);
+    size_t k = 0;
+    if constexpr (sizeof(LimbT) == 8) {
+#if defined(NUMETRON_USE_ASM) && (defined(__x86_64__) || defined(_M_X64)) && defined(NUMETRON_PLATFORM_AUTODETECT)
+        if (limbs <= NUMETRON_BATCH_MUL_MAX_LIMBS) {
+            if (auto kernel = kernel_table.batch_mul[limbs - 1]) {
+                k = kernel(reinterpret_cast<uint64_t const*>(a), reinterpret_cast<uint64_t const*>(b), count, reinterpret_cast<uint64_t*>(r));
+            }
+        }
+#endif
+    }
+
+    // the rest number by number through the base case
+    small_array<LimbT, 4 * NUMETRON_BATCH_MUL_MAX_LIMBS, std::allocator<LimbT>> work(4 * limbs);
+    LimbT* u = work.data(), * v = u + limbs, * w = v + limbs;
+    for (; k < count; ++k) {
+        for (size_t i = 0; i < limbs; ++i) {
+            u[i] = a[i * count + k];
+            v[i] = b[i * count + k];
+        }
+        if constexpr (sizeof(LimbT) == 8) {
+            umul_basecase<LimbT>(u, limbs, v, limbs, w);
+        } else {
+            LimbT* p = w;
+            w[limbs] = umul1<LimbT>(u, u + limbs, v[0], p);
+            for (size_t j = 1; j < limbs; ++j) {
+                p = w + j;
+                const LimbT c = umul1_add<LimbT>(u, u + limbs, v[j], p);
+                *p = c;
+            }
+        }
+        for (size_t i = 0; i < 2 * limbs; ++i) r[i * count + k] = w[i];
+    }
+}
+
+}
@@ -0,0 +1,165 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <immintrin.h>
+
+#include "umul_basecase_ifma.hpp"
+
+// the AVX-512 intrinsics of GCC 12 set off -Wuninitialized on their own undefined pass-through operands
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// the lane-parallel kernels of ubatch_mul take the numbers of up to this many limbs
+#ifndef NUMETRON_BATCH_MUL_MAX_LIMBS
+#   define NUMETRON_BATCH_MUL_MAX_LIMBS 8
+#endif
+
+// the AVX2 kernel works in the 2^32 radix and beats the scalar base case only for the shortest numbers
+#ifndef NUMETRON_BATCH_MUL_AVX2_MAX_LIMBS
+#   define NUMETRON_BATCH_MUL_AVX2_MAX_LIMBS 3
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define NUMETRON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define NUMETRON_TARGET_AVX2
+#endif
+
+namespace numetron::limb_arithmetic {
+
+// a lane-parallel kernel multiplies the first count - count % lanes numbers of the batch, see ubatch_mul();
+// returns the number of the multiplied numbers
+typedef size_t (*batch_mul_type)(uint64_t const* a, uint64_t const* b, size_t count, uint64_t* r);
+using batch_mul_kernels = std::array<batch_mul_type, NUMETRON_BATCH_MUL_MAX_LIMBS>;
+
+// four numbers at a time in the 2^32 radix: every product of two halves is split into the low half, added to its
+// column, and the high half, added to the next one; a column takes at most 4N halves below 2^32
+template <size_t N>
+NUMETRON_TARGET_AVX2
+size_t ubatch_mul_avx2(uint64_t const* a, uint64_t const* b, size_t count, uint64_t* r) noexcept
+{
+    constexpr size_t H = 2 * N;
+    const __m256i m = _mm256_set1_epi64x(0xFFFFFFFF);
+    const size_t n = count - count % 4;
+    for (size_t k = 0; k < n; k += 4) {
+        // _mm256_mul_epu32 takes the low halves of the lanes, the high halves are shifted down
+        __m256i u[H], v[H], acc[2 * H];
+        for (size_t i = 0; i < N; ++i) {
+            u[2 * i] = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i * count + k));
+            v[2 * i] = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i * count + k));
+            u[2 * i + 1] = _mm256_srli_epi64(u[2 * i], 32);
+            v[2 * i + 1] = _mm256_srli_epi64(v[2 * i], 32);
+        }
+        for (auto& c : acc) c = _mm256_setzero_si256();
+        for (size_t i = 0; i < H; ++i) {
+            for (size_t j = 0; j < H; ++j) {
+                const __m256i p = _mm256_mul_epu32(u[i], v[j]);
+                acc[i + j] = _mm256_add_epi64(acc[i + j], _mm256_and_si256(p, m));
+                acc[i + j + 1] = _mm256_add_epi64(acc[i + j + 1], _mm256_srli_epi64(p, 32));
+            }
+        }
+        __m256i c = _mm256_setzero_si256();
+        for (size_t i = 0; i < H; ++i) {
+            const __m256i lo = _mm256_add_epi64(acc[2 * i], c);
+            c = _mm256_srli_epi64(lo, 32);
+            const __m256i hi = _mm256_add_epi64(acc[2 * i + 1], c);
+            c = _mm256_srli_epi64(hi, 32);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i * count + k),
+                _mm256_or_si256(_mm256_and_si256(lo, m), _mm256_slli_epi64(hi, 32)));
+        }
+    }
+    return n;
+}
+
+// eight numbers at a time in the 2^52 radix: the low and the high halves of the digit products are accumulated
+// by vpmadd52luq and vpmadd52huq without carries, an accumulator takes at most D terms below 2^52
+template <size_t N>
+NUMETRON_TARGET_AVX512IFMA
+size_t ubatch_mul_ifma(uint64_t const* a, uint64_t const* b, size_t count, uint64_t* r) noexcept
+{
+    constexpr size_t D = detail::radix52_size(N);
+    const __m512i m = _mm512_set1_epi64(static_cast<long long>(detail::radix52_mask));
+    const size_t n = count - count % 8;
+    for (size_t k = 0; k < n; k += 8) {
+        __m512i x[N], y[N], u[D], v[D], lo[2 * D], hi[2 * D];
+        for (size_t i = 0; i < N; ++i) {
+            x[i] = _mm512_loadu_si512(a + i * count + k);
+            y[i] = _mm512_loadu_si512(b + i * count + k);
+        }
+        // the digit t starts in the limb 52 t / 64 at the bit 52 t % 64
+        for (size_t t = 0; t < D; ++t) {
+            const size_t w = 52 * t / 64, s = 52 * t % 64;
+            __m512i du = _mm512_srli_epi64(x[w], static_cast<unsigned int>(s));
+            __m512i dv = _mm512_srli_epi64(y[w], static_cast<unsigned int>(s));
+            if (s > 12 && w + 1 < N) {
+                du = _mm512_or_si512(du, _mm512_slli_epi64(x[w + 1], static_cast<unsigned int>(64 - s)));
+                dv = _mm512_or_si512(dv, _mm512_slli_epi64(y[w + 1], static_cast<unsigned int>(64 - s)));
+            }
+            u[t] = _mm512_and_si512(du, m);
+            v[t] = _mm512_and_si512(dv, m);
+        }
+        for (size_t t = 0; t < 2 * D; ++t) lo[t] = hi[t] = _mm512_setzero_si512();
+        for (size_t i = 0; i < D; ++i) {
+            for (size_t j = 0; j < D; ++j) {
+                lo[i + j] = _mm512_madd52lo_epu64(lo[i + j], u[i], v[j]);
+                hi[i + j] = _mm512_madd52hi_epu64(hi[i + j], u[i], v[j]);
+            }
+        }
+        // the column t is lo[t] + hi[t - 1], normalized to 52-bit digits in lo
+        __m512i c = _mm512_setzero_si512();
+        for (size_t t = 0; t < 2 * D; ++t) {
+            __m512i s = _mm512_add_epi64(lo[t], c);
+            if (t) s = _mm512_add_epi64(s, hi[t - 1]);
+            lo[t] = _mm512_and_si512(s, m);
+            c = _mm512_srli_epi64(s, 52);
+        }
+        // the limb i starts in the digit 64 i / 52 at the bit 64 i % 52 and takes two or three digits
+        for (size_t i = 0; i < 2 * N; ++i) {
+            const size_t t = 64 * i / 52, s = 64 * i % 52;
+            __m512i l = _mm512_srli_epi64(lo[t], static_cast<unsigned int>(s));
+            if (t + 1 < 2 * D) l = _mm512_or_si512(l, _mm512_slli_epi64(lo[t + 1], static_cast<unsigned int>(52 - s)));
+            if (s > 40 && t + 2 < 2 * D) l = _mm512_or_si512(l, _mm512_slli_epi64(lo[t + 2], static_cast<unsigned int>(104 - s)));
+            _mm512_storeu_si512(r + i * count + k, l);
+        }
+    }
+    return n;
+}
+
+namespace detail {
+
+template <size_t... Is>
+constexpr batch_mul_kernels make_batch_mul_avx2_kernels(std::index_sequence<Is...>) noexcept
+{
+    return { (Is < NUMETRON_BATCH_MUL_AVX2_MAX_LIMBS ? &ubatch_mul_avx2<Is + 1> : nullptr)... };
+}
+
+template <size_t... Is>
+constexpr batch_mul_kernels make_batch_mul_ifma_kernels(std::index_sequence<Is...>) noexcept
+{
+    return { &ubatch_mul_ifma<Is + 1>... };
+}
+
+}
+
+inline constexpr batch_mul_kernels batch_mul_avx2_kernels =
+    detail::make_batch_mul_avx2_kernels(std::make_index_sequence<NUMETRON_BATCH_MUL_MAX_LIMBS>{});
+
+inline constexpr batch_mul_kernels batch_mul_ifma_kernels =
+    detail::make_batch_mul_ifma_kernels(std::make_index_sequence<NUMETRON_BATCH_MUL_MAX_LIMBS>{});
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
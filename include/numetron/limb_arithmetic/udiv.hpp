@@ -4,10 +4,30 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "udivby1.hpp"
+#include "uadd.hpp"
+#include "usub.hpp"
+#include "umul.hpp"
+
+// divisors from this size (in limbs) are divided with the Newton reciprocal, if the quotient is not shorter
+#ifndef NUMETRON_DIV_NEWTON_THRESHOLD
+#   define NUMETRON_DIV_NEWTON_THRESHOLD 80
+#endif
+
+// reciprocals from this size (in limbs) are computed by the Newton iteration, smaller ones by the base case division
+#ifndef NUMETRON_INV_NEWTON_THRESHOLD
+#   define NUMETRON_INV_NEWTON_THRESHOLD 40
+#endif
 
 namespace numetron::limb_arithmetic {
 
+inline bool is_div_newton_applicable(size_t qn, size_t dn) noexcept
+{
+    return dn >= NUMETRON_DIV_NEWTON_THRESHOLD && qn >= NUMETRON_DIV_NEWTON_THRESHOLD;
+}
+
 // base case u / d
 // prereqs: u < d * B^m, d normilized, where m = size(u) - size(d) in limbs, B = 2^bitsize(limb)
 // returns {rhh, rh}; [rl] -> u
@@ -19,7 +39,9 @@ std::pair<LimbT, LimbT> udiv_bc_unorm(LimbT* puhh, LimbT* puh, std::span<LimbT>&
     size_t m = ul.size() - dl.size() + 1;
     
     if (m) {
-        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> daux{ dl.size(), alloc };
+        // daux stores qj * dl and the middle limb of qj * d
+        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> daux{ dl.size() + 1, alloc };
+        auto dauxl = daux.span().first(dl.size());
 
 #if defined(NUMETRON_ARITHMETIC_USE_INVINT_DIV)
         auto [dinv, _] = numetron::arithmetic::udiv2by1<LimbT>(~dh + 1, 0, dh);
@@ -45,7 +67,7 @@ std::pair<LimbT, LimbT> udiv_bc_unorm(LimbT* puhh, LimbT* puh, std::span<LimbT>&
                 LimbT mdh = *(tmpr - 1);
                 // u - dh * B^j
                 auto usp = ul.last(dl.size());
-                LimbT uc = usub<LimbT>(usp, daux, usp);
+                LimbT uc = usub<LimbT>(usp, dauxl, usp);
                 std::tie(uc, *puh) = numetron::arithmetic::usub1c(*puh, mdh, uc);
                 std::tie(uc, *puhh) = numetron::arithmetic::usub1c(*puhh, mdhh, uc);
 
@@ -284,58 +306,258 @@ inline void udiv_dv(LimbT* puhh, LimbT* puh, std::span<LimbT>& ul, std::span<Lim
     LimbT c = usub<LimbT>(r1h, ul2, { q1d0, q1d0sz });
 }
 
+// {d, n} / {x, n}: x is the n low limbs of floor((B^2n - 1) / d), the reciprocal of d scaled by B^2n, its high limb
+// is always 1 and not stored
+// prereqs: d is normalized
+// Newton iteration: the reciprocal of the high half of d is refined by one step, which doubles its precision,
+// and the result is corrected to be exact, so the recursion always starts from an exact reciprocal
+template <std::unsigned_integral LimbT, typename AllocatorT>
+void uinv(LimbT const* d, size_t n, LimbT* x, AllocatorT&& alloc)
+{
+    using allocator_type = std::remove_cvref_t<AllocatorT>;
+    using buffer_t = small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type>;
+
+    assert(n && (d[n - 1] >> (std::numeric_limits<LimbT>::digits - 1)));
+
+    allocator_type a{ alloc };
+    if (n == 1) {
+        *x = numetron::arithmetic::udiv2by1<LimbT>(~*d, ~LimbT{ 0 }, *d).first;
+        return;
+    }
+
+    bool newton = false;
+    if constexpr (sizeof(LimbT) == 8) newton = n >= NUMETRON_INV_NEWTON_THRESHOLD;
+    if (!newton) {
+        // B^2n - 1 - d * B^n = (B^n - 1 - d) * B^n + B^n - 1, its quotient by d is x
+        buffer_t wbuf(2 * n, alloc);
+        LimbT* w = wbuf.data();
+        std::fill(w, w + n, ~LimbT{ 0 });
+        for (size_t i = 0; i < n; ++i) w[n + i] = ~d[i];
+        std::span<LimbT> wl{ w, 2 * n - 2 };
+        udiv_bc_unorm<LimbT>(&w[2 * n - 1], &w[2 * n - 2], wl, d[n - 1], std::span<const LimbT>{ d, n - 1 }, x + n - 1, a);
+        return;
+    }
+
+    if constexpr (sizeof(LimbT) == 8) {
+        auto mul = [&a](LimbT const* u, size_t un, LimbT const* v, size_t vn, LimbT* r) {
+            LimbT* e = umul_dispatch<LimbT>(u, un, v, vn, r, a);
+            std::fill(e, r + un + vn, 0);
+        };
+
+        // ah = B^h + xh ~ B^2h / dh, where dh is the high h limbs of d
+        const size_t h = (n + 1) / 2, l = n - h;
+        buffer_t ahbuf(h + 1, alloc);
+        LimbT* ah = ahbuf.data();
+        uinv<LimbT>(d + l, h, ah, a);
+        ah[h] = 1;
+
+        // t = B^(n + h) - ah * d, |t| < 2 * B^n since ah * dh <= B^2h - 1 < (ah + 1) * dh
+        buffer_t pbuf(n + h + 1, alloc);
+        LimbT* p = pbuf.data();
+        mul(ah, h + 1, d, n, p);
+        const bool negative = p[n + h];
+        if (!negative) {
+            // two's complement of p[0, n + h)
+            for (size_t i = 0; i < n + h; ++i) p[i] = ~p[i];
+            uadd_limb<LimbT>(p, p + n + h, 1);
+        }
+        assert(std::all_of(p + n + 1, p + n + h, [](LimbT v) { return !v; }));
+
+        // x' = ah * B^l + ah * t / B^2h
+        buffer_t sbuf(n + h + 2, alloc);
+        LimbT* s = sbuf.data();
+        mul(ah, h + 1, p, n + 1, s);
+        buffer_t xbuf(n + 1, alloc);
+        LimbT* xa = xbuf.data();
+        std::fill(xa, xa + l, 0);
+        std::copy(ah, ah + h + 1, xa + l);
+        if (negative) {
+            LimbT c = usub_inplace<LimbT>(xa, s + 2 * h, s + n + h + 2);
+            usub_limb<LimbT>(xa + l + 2, xa + n + 1, c);
+        } else {
+            LimbT c = uadd_inplace<LimbT>(xa, s + 2 * h, s + n + h + 2);
+            uadd_limb<LimbT>(xa + l + 2, xa + n + 1, c);
+        }
+
+        // exact correction: 0 <= B^2n - 1 - x' * d < d
+        buffer_t qbuf(2 * n + 1, alloc);
+        LimbT* q = qbuf.data();
+        mul(xa, n + 1, d, n, q);
+        while (q[2 * n]) {
+            usub_limb<LimbT>(xa, xa + n + 1, 1);
+            LimbT c = usub_inplace<LimbT>(q, d, d + n);
+            usub_limb<LimbT>(q + n, q + 2 * n + 1, c);
+        }
+        for (size_t i = 0; i < 2 * n; ++i) q[i] = ~q[i];
+        for (;;) {
+            bool ge = std::any_of(q + n, q + 2 * n, [](LimbT v) { return !!v; });
+            if (!ge) {
+                size_t i = n;
+                while (i && q[i - 1] == d[i - 1]) --i;
+                ge = !i || q[i - 1] > d[i - 1];
+            }
+            if (!ge) break;
+            uadd_limb<LimbT>(xa, xa + n + 1, 1);
+            LimbT c = usub_inplace<LimbT>(q, d, d + n);
+            usub_limb<LimbT>(q + n, q + 2 * n, c);
+        }
+        assert(xa[n] == 1);
+        std::copy(xa, xa + n, x);
+    }
+}
+
+// Barrett division: {w, wn} / {d, n} -> q (from high to low), wn - n limbs, the remainder is left in w[0, n)
+// x is the reciprocal (see uinv) of the high xn limbs of d, xn <= n; the quotient is estimated xn limbs at a time
+// by the product of the high limbs of the current remainder and x, then corrected by a few additions or subtractions of d
+// prereqs: d is normalized, w < d * B^(wn - n)
 template <std::unsigned_integral LimbT, typename QOutputIteratorT, typename AllocatorT>
-LimbT udiv(LimbT uh, std::span<LimbT>& ul, LimbT dh, std::span<const LimbT> dl, QOutputIteratorT qit, AllocatorT && alloc)
+void udiv_barrett(LimbT* w, size_t wn, LimbT const* d, size_t n, LimbT const* x, size_t xn, QOutputIteratorT qit, AllocatorT&& alloc)
 {
-    //using allocator_type = std::remove_cvref_t<AllocatorT>;
-    //using alloc_traits_t = std::allocator_traits<allocator_type>;
+    using allocator_type = std::remove_cvref_t<AllocatorT>;
+    using buffer_t = small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type>;
+
+    assert(wn >= n && xn && xn <= n);
+
+    allocator_type a{ alloc };
+    auto mul = [&a](LimbT const* u, size_t un, LimbT const* v, size_t vn, LimbT* r) {
+        LimbT* e = umul_dispatch<LimbT>(u, un, v, vn, r, a);
+        std::fill(e, r + un + vn, 0);
+    };
+    // u[0, n) >= d
+    auto ge_d = [d, n](LimbT const* u) {
+        size_t i = n;
+        while (i && u[i - 1] == d[i - 1]) --i;
+        return !i || u[i - 1] > d[i - 1];
+    };
+
+    buffer_t tbuf(n + xn + 1, alloc);
+    LimbT* t = tbuf.data();
+    buffer_t qbuf(xn, alloc);
+    LimbT* qb = qbuf.data();
+
+    // w[pos, wn) is the current remainder, it is less than d
+    for (size_t pos = wn - n; pos;) {
+        const size_t k = (std::min)(xn, pos);
+        pos -= k;
+        LimbT* nb = w + pos; // the partial dividend nb[0, n + k), its quotient by d has k limbs
+
+        // q ~ floor(nh * (B^xn + x) / B^xn), where nh is the high k limbs of the partial dividend
+        LimbT const* nh = nb + n;
+        mul(nh, k, x, xn, t);
+        std::copy(t + xn, t + xn + k, qb);
+        LimbT c = uadd_inplace<LimbT>(qb, nh, nh + k);
+        if (c) {
+            // only possible with a reciprocal of the truncated divisor, the estimate is too large anyway
+            std::fill(qb, qb + k, ~LimbT{ 0 });
+        }
 
-    LimbT* puh;
-    if (!uh) {
-        puh = &ul.back();
-        ul = ul.first(ul.size() - 1);
-    } else {
-        puh = &uh;
+        // the estimate exceeds the quotient if x is the reciprocal of a truncated divisor
+        mul(qb, k, d, n, t);
+        for (;;) {
+            size_t i = n + k;
+            while (i && t[i - 1] == nb[i - 1]) --i;
+            if (!i || t[i - 1] < nb[i - 1]) break;
+            usub_limb<LimbT>(qb, qb + k, 1);
+            c = usub_inplace<LimbT>(t, d, d + n);
+            usub_limb<LimbT>(t + n, t + n + k, c);
+        }
+        usub_inplace<LimbT>(nb, t, t + n + k);
+
+        // the estimate is short of the quotient by a few units
+        while (std::any_of(nb + n, nb + n + k, [](LimbT v) { return !!v; }) || ge_d(nb)) {
+            uadd_limb<LimbT>(qb, qb + k, 1);
+            c = usub_inplace<LimbT>(nb, d, d + n);
+            usub_limb<LimbT>(nb + n, nb + n + k, c);
+        }
+
+        for (size_t j = k; j--;) {
+            *qit = qb[j]; --qit;
+        }
     }
+}
 
-    // normalization
-    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> optdnorm(0, alloc);
-    const LimbT* dlnorm;
-    LimbT uhhstore = 0;
-    int shift = numetron::arithmetic::count_leading_zeros(dh);
+// as udiv, but the divisor is given normalized: {dh, dl} = d * 2^shift, the high bit of dh is set
+// dinv is an optional reciprocal of the normalized divisor (see uinv) for the Newton division, it is computed if needed and not given
+template <std::unsigned_integral LimbT, typename QOutputIteratorT, typename AllocatorT>
+LimbT udiv_dnorm(LimbT uh, std::span<LimbT>& ul, int shift, LimbT dh, std::span<const LimbT> dl, QOutputIteratorT qit, AllocatorT && alloc, LimbT const* dinv = nullptr)
+{
+    using allocator_type = std::remove_cvref_t<AllocatorT>;
+
+    assert(dh >> (std::numeric_limits<LimbT>::digits - 1));
+    assert(!dl.empty());
+
+    LimbT th = uh ? uh : ul.back();
+    std::span<const LimbT> tl = uh ? ul : ul.first(ul.size() - 1);
+    const size_t un = tl.size() + 1;
+    assert(un > dl.size());
+
+    // normalization: w = u * 2^shift gets one more limb on top, so w[un] < dh and the base case can start right away
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type> wbuf(un + 1, alloc);
+    LimbT* w = wbuf.data();
     if (shift) {
-        optdnorm.reset(dl.size());
-        ushift_left<LimbT>(dh, dl, shift, optdnorm.data()); // returns 0
-        uhhstore = ushift_left<LimbT>(*puh, ul, shift, ul.data());
-        dlnorm = optdnorm.data();
+        w[un] = ushift_left<LimbT>(th, tl, shift, w);
     } else {
-        dlnorm = dl.data();
+        std::copy(tl.begin(), tl.end(), w);
+        w[un] = 0;
     }
-    
-    LimbT* puhh = &uhhstore;
-    if (!uhhstore) {
-        puhh = puh;
-        puh = &ul.back();
-        ul = ul.first(ul.size() - 1);
+    w[un - 1] = th;
+
+    allocator_type a{ alloc };
+    bool newton = false;
+    if constexpr (sizeof(LimbT) == 8) newton = is_div_newton_applicable(un - dl.size(), dl.size() + 1);
+    if (newton) {
+        const size_t dn = dl.size() + 1;
+        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type> dbuf(dn, alloc);
+        std::copy(dl.begin(), dl.end(), dbuf.data());
+        dbuf.back() = dh;
+        if (dinv) {
+            udiv_barrett<LimbT>(w, un + 1, dbuf.data(), dn, dinv, dn, std::move(qit), a);
+        } else {
+            // the reciprocal of the high xn limbs of d is enough for quotient blocks of xn limbs
+            const size_t qn = un - dl.size();
+            const size_t blocks = (qn + dn - 1) / dn;
+            const size_t xn = (qn + blocks - 1) / blocks;
+            small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type> xbuf(xn, alloc);
+            uinv<LimbT>(dbuf.data() + dn - xn, xn, xbuf.data(), a);
+            udiv_barrett<LimbT>(w, un + 1, dbuf.data(), dn, xbuf.data(), xn, std::move(qit), a);
+        }
+    } else {
+        LimbT* puhh = &w[un];
+        LimbT* puh = &w[un - 1];
+        std::span<LimbT> wl{ w, un - 1 };
+        udiv_bc_unorm<LimbT>(puhh, puh, wl, dh, dl, std::move(qit), a);
     }
-    assert(*puhh);
-    //auto [rhh, rh] = udiv_dv(puhh, puh, ul, dh, { dlnorm, dl.size() }, std::move(qit), alloc);
-    auto [rhh, rh] = udiv_svoboda(puhh, puh, ul, dh, { dlnorm, dl.size() }, std::move(qit), alloc);
-    //auto [rhh, rh] = udiv_bc(puhh, puh, ul, dh, { dlnorm, dl.size() }, std::move(qit), alloc);
+
+    // the normalized remainder is w[0, dl.size()]
+    LimbT rh = w[dl.size()];
     if (shift) {
-        ushift_right<LimbT>(rh, ul, shift); // returns 0
-        if (rhh) {
-            rh |= (rhh << (std::numeric_limits<LimbT>::digits - shift));
-        }
-    } else if (rhh) {
-        ul = { ul.data(), ul.size() + 1 };
-        assert(ul.back() == rh);
-        rh = rhh;
+        ushift_right<LimbT>(rh, std::span<const LimbT>{ w, dl.size() }, shift, ul.data());
+    } else {
+        std::copy(w, w + dl.size(), ul.data());
     }
-    
+    ul = ul.first(dl.size());
     return rh;
 }
 
+// {uh, ul} / {dh, dl} -> q, the quotient limbs are written from high to low: size(u) - size(d) + 1 limbs,
+// where uh is not counted if it is 0
+// prereqs: size(u) >= size(d), dh != 0, dl is not empty
+// the remainder is {rh, ul}: its low limbs are written to ul, ul is shrunk to dl.size() limbs, returns rh
+template <std::unsigned_integral LimbT, typename QOutputIteratorT, typename AllocatorT>
+LimbT udiv(LimbT uh, std::span<LimbT>& ul, LimbT dh, std::span<const LimbT> dl, QOutputIteratorT qit, AllocatorT && alloc)
+{
+    using allocator_type = std::remove_cvref_t<AllocatorT>;
+
+    assert(dh);
+    int shift = numetron::arithmetic::count_leading_zeros(dh);
+    if (!shift) {
+        return udiv_dnorm<LimbT>(uh, ul, 0, dh, dl, std::move(qit), alloc);
+    }
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, allocator_type> dnorm(dl.size(), alloc);
+    ushift_left<LimbT>(dh, dl, shift, dnorm.data()); // returns 0
+    return udiv_dnorm<LimbT>(uh, ul, shift, dh, dnorm.span(), std::move(qit), alloc);
+}
+
 // prereqs: u >= d, d.back() > 0
 // {uh, ul} / d -> q(from high to low); rl -> ul, returns rh
 // uh can be 0, daux.size() >= d.size()
@@ -485,6 +707,8 @@ LimbT udiv2(LimbT& uh, std::span<LimbT>& ul, LimbT dh, std::span<const LimbT> dl
     return udiv2<LimbT>(uh, ul, d, daux, std::move(qit));
 }
 
+// u / v -> q, u mod v -> r, the limbs of q and r above the results are zeroed
+// prereqs: q.size() >= u.size(), r.size() >= v.size()
 template <std::unsigned_integral LimbT>
 inline void udiv(std::span<const LimbT> u, std::span<const LimbT> v, std::span<LimbT> q, std::span<LimbT> r)
 {
@@ -500,7 +724,24 @@ inline void udiv(std::span<const LimbT> u, std::span<const LimbT> v, std::span<L
         std::memset(r.data() + 1, 0, (r.size() - 1) * sizeof(LimbT));
         return;
     }
-    throw std::runtime_error("not implemented");
+
+    size_t un = u.size();
+    while (un && !u[un - 1]) --un;
+    const size_t vn = ve - vb;
+    std::fill(q.begin(), q.end(), 0);
+    std::fill(r.begin(), r.end(), 0);
+    if (un < vn) {
+        std::copy(u.data(), u.data() + un, r.data());
+        return;
+    }
+
+    std::allocator<LimbT> alloc;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, std::allocator<LimbT>> ubuf(un, alloc);
+    std::copy(u.data(), u.data() + un, ubuf.data());
+    std::span<LimbT> ul = ubuf.span();
+    LimbT rh = udiv<LimbT>(LimbT{ 0 }, ul, *(ve - 1), std::span<const LimbT>{ vb, vn - 1 }, q.data() + un - vn, alloc);
+    std::copy(ul.begin(), ul.end(), r.data());
+    r[vn - 1] = rh;
 }
 
 }
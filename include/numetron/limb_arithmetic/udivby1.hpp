@@ -7,6 +7,7 @@
 #include <concepts>
 #include <limits>
 #include <span>
+#include <bit>
 
 #include "numetron/arithmetic.hpp"
 #include "numetron/ct.hpp"
@@ -147,6 +148,18 @@ auto udivby1(LimbT uh, std::span<LimbT> ul, LimbT d, LimbT invd, int l) -> LimbT
 }
 #endif
 
+// returns u mod d, the quotient is not stored
+template <std::unsigned_integral LimbT>
+inline LimbT umod1(std::span<const LimbT> u, LimbT d) noexcept
+{
+    assert(d);
+    LimbT r = 0;
+    for (size_t i = u.size(); i-- > 0;) {
+        r = numetron::arithmetic::udiv2by1<LimbT>(r, u[i], d).second;
+    }
+    return r;
+}
+
 // returns remainder
 template <std::unsigned_integral LimbT>
 auto udivby1(std::span<const LimbT> ls, LimbT d, std::span<LimbT> q) -> LimbT
@@ -321,4 +334,56 @@ auto udivby1(std::span<LimbT> ls) // -> std::pair<LimbT, LimbT>
     }
 }
 
+// the inverse of an odd d modulo B
+template <std::unsigned_integral LimbT>
+constexpr LimbT binvert1(LimbT d) noexcept
+{
+    assert(d & 1);
+    // d * d == 1 mod 8 for an odd d, every Newton step doubles the number of correct bits
+    LimbT dinv = d;
+    for (int bits = 3; bits < std::numeric_limits<LimbT>::digits; bits *= 2) {
+        dinv = static_cast<LimbT>(dinv * static_cast<LimbT>(2 - static_cast<LimbT>(d * dinv)));
+    }
+    return dinv;
+}
+
+// exact division by a single limb: q <- ls / d, the remainder must be 0
+// d = 2^t * d', ls is shifted right by t on the fly and the quotient is developed from the low end
+// by multiplying with the inverse of d' modulo B, so there is no division in the loop.
+// q may alias ls.
+template <std::unsigned_integral LimbT>
+void udivexact_by1(std::span<const LimbT> ls, LimbT d, std::span<LimbT> q) noexcept
+{
+    assert(d);
+    assert(q.size() >= ls.size());
+    assert(!ls.empty());
+
+    constexpr int limb_bits = std::numeric_limits<LimbT>::digits;
+    const int t = std::countr_zero(d);
+    d >>= t;
+
+    const LimbT dinv = binvert1(d);
+
+    const size_t n = ls.size();
+    LimbT const* src = ls.data();
+    LimbT* dst = q.data();
+    LimbT c = 0;
+    auto step = [&c, d, dinv](LimbT s) noexcept -> LimbT {
+        LimbT b = s < c;
+        s -= c;
+        LimbT qi = static_cast<LimbT>(s * dinv);
+        c = static_cast<LimbT>(arithmetic::umul1(qi, d).first + b);
+        return qi;
+    };
+    if (!t) {
+        for (size_t i = 0; i < n; ++i) dst[i] = step(src[i]);
+    } else {
+        for (size_t i = 0; i + 1 < n; ++i) {
+            dst[i] = step(static_cast<LimbT>((src[i] >> t) | static_cast<LimbT>(src[i + 1] << (limb_bits - t))));
+        }
+        dst[n - 1] = step(static_cast<LimbT>(src[n - 1] >> t));
+    }
+    assert(!c);
+}
+
 }
@@ -0,0 +1,149 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include "numetron/limb_arithmetic.hpp"
+#include "udiv.hpp"
+#include "umul1.hpp"
+
+// exact divisors from this size (in limbs) are divided by blocks with the 2-adic inverse, smaller ones limb by limb
+#ifndef NUMETRON_BDIV_Q_THRESHOLD
+#   define NUMETRON_BDIV_Q_THRESHOLD 24
+#endif
+
+namespace numetron::limb_arithmetic {
+
+namespace detail {
+
+// u v mod B^rn -> r[rn], w has room for un + vn limbs
+template <std::unsigned_integral LimbT, typename AllocatorT>
+void umul_low(LimbT const* u, size_t un, LimbT const* v, size_t vn, LimbT* r, size_t rn, LimbT* w, AllocatorT& alloc)
+{
+    un = (std::min)(un, rn);
+    vn = (std::min)(vn, rn);
+    while (un && !u[un - 1]) --un;
+    while (vn && !v[vn - 1]) --vn;
+    size_t wn = 0;
+    if (un && vn) {
+        wn = (std::min)(static_cast<size_t>(umul_dispatch<LimbT>(u, un, v, vn, w, alloc) - w), rn);
+    }
+    std::copy(w, w + wn, r);
+    std::fill(r + wn, r + rn, LimbT{ 0 });
+}
+
+// (u >> shift) mod B^rn -> r[rn]; r has room for rn + 1 limbs and may be u
+template <std::unsigned_integral LimbT>
+void ushift_right_low(LimbT const* u, size_t un, unsigned int shift, LimbT* r, size_t rn) noexcept
+{
+    const size_t m = (std::min)(un, rn + 1);
+    if (!shift) {
+        std::copy(u, u + m, r);
+    } else if (m) {
+        LimbT uh = u[m - 1];
+        ushift_right<LimbT>(uh, std::span<const LimbT>{ u, m - 1 }, shift, r);
+        r[m - 1] = uh;
+    }
+    if (m < rn) std::fill(r + m, r + rn, LimbT{ 0 });
+}
+
+}
+
+// d^-1 mod B^k -> r[k] by Newton's steps x' = x (2 - d x), every step doubles the number of correct limbs
+// prereqs: d[0] is odd, r does not overlap d
+template <std::unsigned_integral LimbT, typename AllocatorT>
+void ubinvert(LimbT const* d, size_t dn, size_t k, LimbT* r, AllocatorT alloc)
+{
+    assert(dn && k && (d[0] & 1));
+
+    // the precisions from the top: k, ceil(k / 2), ..., 1
+    std::array<size_t, std::numeric_limits<size_t>::digits + 1> sizes;
+    size_t sn = 0;
+    for (size_t m = k; m > 1; m = (m + 1) / 2) sizes[sn++] = m;
+
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(4 * k, alloc);
+    LimbT* t = work.data(), * w = t + k;
+    r[0] = binvert1(d[0]);
+    for (size_t m = 1; sn; m = sizes[sn]) {
+        const size_t m2 = sizes[--sn], hn = m2 - m;
+        // d x = 1 + B^m h (mod B^m2)
+        detail::umul_low(d, dn, r, m, t, m2, w, alloc);
+        // x - B^m (x h mod B^hn) -> x; hn <= m
+        detail::umul_low(r, hn, t + m, hn, r + m, hn, w, alloc);
+        LimbT c = 1;
+        for (size_t i = m; i < m2; ++i) {
+            r[i] = static_cast<LimbT>(~r[i] + c);
+            c &= static_cast<LimbT>(!r[i]);
+        }
+    }
+}
+
+// n / d -> q[nn - dn + 1] for a d that divides n exactly, the quotient is developed from the low end by the 2-adic
+// inverse of d (Jebelean's exact division): q = n d^-1 mod B^qn, no remainder is computed; returns the size of q
+// prereqs: d | n, d != 0, q does not overlap n and d
+template <std::unsigned_integral LimbT, typename AllocatorT>
+size_t udivexact(LimbT const* n, size_t nn, LimbT const* d, size_t dn, LimbT* q, AllocatorT alloc)
+{
+    while (nn && !n[nn - 1]) --nn;
+    while (dn && !d[dn - 1]) --dn;
+    assert(dn);
+    if (nn < dn) return 0;
+
+    // the zero limbs of d are the zero limbs of n
+    for (; !d[0]; ++d, --dn, ++n, --nn) assert(!n[0]);
+
+    size_t qn = nn - dn + 1;
+    if (dn == 1) {
+        udivexact_by1<LimbT>(std::span<const LimbT>{ n, nn }, d[0], std::span<LimbT>{ q, nn });
+        while (qn && !q[qn - 1]) --qn;
+        return qn;
+    }
+
+    // n' = n / 2^t mod B^qn, d' = d / 2^t mod B^qn, where d' is odd
+    const unsigned int t = std::countr_zero(d[0]);
+    const size_t en = (std::min)(dn, qn);
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(qn + en + 2, alloc);
+    LimbT* u = work.data(), * v = u + qn + 1;
+    detail::ushift_right_low(n, nn, t, u, qn);
+    detail::ushift_right_low(d, dn, t, v, en);
+    size_t vn = en;
+    while (!v[vn - 1]) --vn;
+
+    if (vn < NUMETRON_BDIV_Q_THRESHOLD) {
+        // limb by limb: q_i = u_i d'^-1 mod B, u - q_i d' B^i -> u zeroes u_i
+        const LimbT dinv = binvert1(v[0]);
+        for (size_t i = 0; i < qn; ++i) {
+            const LimbT qi = static_cast<LimbT>(u[i] * dinv);
+            q[i] = qi;
+            LimbT* p = u + i;
+            const LimbT c = umul1_sub<LimbT>(v, v + (std::min)(vn, qn - i), qi, p);
+            usub_limb<LimbT>(p, u + qn, c);
+        }
+    } else {
+        // by blocks of k limbs: q_blk = u_blk d'^-1 mod B^k, then the product q_blk d' is taken off the limbs above
+        const size_t bn = (qn + vn - 1) / vn, k = (qn + bn - 1) / bn;
+        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> buf(k + 2 * (k + vn), alloc);
+        LimbT* dinv = buf.data(), * p = dinv + k, * w = p + k + vn;
+        ubinvert<LimbT>(v, vn, k, dinv, alloc);
+        for (size_t o = 0; o < qn; o += k) {
+            const size_t kn = (std::min)(k, qn - o);
+            detail::umul_low(u + o, kn, dinv, kn, q + o, kn, w, alloc);
+            const size_t rest = qn - o - kn;
+            if (!rest) break;
+            const size_t pn = (std::min)(kn + vn, kn + rest);
+            detail::umul_low(q + o, kn, v, vn, p, pn, w, alloc);
+            // the low kn limbs of the product are the block itself
+            const LimbT c = usub_inplace<LimbT>(u + o + kn, p + kn, p + pn);
+            usub_limb<LimbT>(u + o + pn, u + qn, c);
+        }
+    }
+    while (qn && !q[qn - 1]) --qn;
+    return qn;
+}
+
+}
@@ -0,0 +1,629 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "udiv.hpp"
+#include "umul1.hpp"
+
+// operands from this size (in limbs) are reduced by the half-gcd, smaller ones by Lehmer's steps
+#ifndef NUMETRON_GCD_DC_THRESHOLD
+#   define NUMETRON_GCD_DC_THRESHOLD 160
+#endif
+
+// the half-gcd recurses on the leading parts from this size (in limbs), smaller ones are reduced by Lehmer's steps
+#ifndef NUMETRON_HGCD_THRESHOLD
+#   define NUMETRON_HGCD_THRESHOLD 60
+#endif
+
+namespace numetron::limb_arithmetic {
+
+// binary gcd of two limbs
+template <std::unsigned_integral LimbT>
+constexpr LimbT ugcd1(LimbT u, LimbT v) noexcept
+{
+    if (!u) return v;
+    if (!v) return u;
+    const int k = std::countr_zero(static_cast<LimbT>(u | v));
+    u >>= std::countr_zero(u);
+    do {
+        v >>= std::countr_zero(v);
+        if (u > v) std::swap(u, v);
+        v -= u;
+    } while (v);
+    return u << k;
+}
+
+// the magnitudes of the cofactors of a Lehmer's step {u, v} -> {u', v'}:
+// for an even number of quotients u' = a u - b v, v' = d v - c u, for an odd number u' = b v - a u, v' = c u - d v;
+// conversely {u, v} = [[d, b], [c, a]] {u', v'}
+template <std::unsigned_integral LimbT>
+struct lehmer_cofactors
+{
+    LimbT a, b, c, d;
+    bool odd;
+};
+
+// the limb of u starting at the bit position shift
+template <std::unsigned_integral LimbT>
+[[nodiscard]] inline LimbT lehmer_digit(LimbT const* u, size_t un, size_t shift) noexcept
+{
+    constexpr unsigned int limb_bits = std::numeric_limits<LimbT>::digits;
+    const size_t i = shift / limb_bits;
+    const unsigned int o = shift % limb_bits;
+    if (i >= un) return 0;
+    LimbT x = u[i] >> o;
+    if (o && i + 1 < un) x |= u[i + 1] << (limb_bits - o);
+    return x;
+}
+
+// Knuth's Algorithm 4.5.2L: the quotients that the leading limb_bits - 2 bits of u and v determine unambiguously
+// returns false if there are none
+// prereqs: u >= v, un > 0, u[un - 1] != 0
+template <std::unsigned_integral LimbT>
+[[nodiscard]] bool lehmer_step(LimbT const* u, size_t un, LimbT const* v, size_t vn, lehmer_cofactors<LimbT>& cf) noexcept
+{
+    using slimb_t = std::make_signed_t<LimbT>;
+    constexpr size_t digit_bits = std::numeric_limits<LimbT>::digits - 2;
+
+    const size_t bits = un * std::numeric_limits<LimbT>::digits - arithmetic::count_leading_zeros(u[un - 1]);
+    const size_t shift = bits > digit_bits ? bits - digit_bits : 0;
+    slimb_t x = static_cast<slimb_t>(lehmer_digit(u, un, shift));
+    slimb_t y = static_cast<slimb_t>(lehmer_digit(v, vn, shift));
+
+    slimb_t a = 1, b = 0, c = 0, d = 1;
+    bool odd = false;
+    while (y + c && y + d) {
+        const slimb_t q = (x + a) / (y + c);
+        if (q != (x + b) / (y + d)) break;
+        slimb_t t = a - q * c; a = c; c = t;
+        t = b - q * d; b = d; d = t;
+        t = x - q * y; x = y; y = t;
+        odd = !odd;
+    }
+    if (!b) return false;
+    auto mag = [](slimb_t x) { return static_cast<LimbT>(x < 0 ? -x : x); };
+    cf = { mag(a), mag(b), mag(c), mag(d), odd };
+    return true;
+}
+
+// r <- u * x - v * y, returns the size of r
+// prereqs: the difference is nonnegative, r has room for max(un, vn) + 1 limbs
+template <std::unsigned_integral LimbT>
+size_t umul1_diff(LimbT const* u, size_t un, LimbT x, LimbT const* v, size_t vn, LimbT y, LimbT* r) noexcept
+{
+    const size_t n = (std::max)(un, vn);
+    if (un && x) {
+        LimbT* rp = r;
+        r[un] = umul1<LimbT>(u, u + un, x, rp);
+        std::fill(r + un + 1, r + n + 1, LimbT{ 0 });
+    } else {
+        std::fill(r, r + n + 1, LimbT{ 0 });
+    }
+    if (vn && y) {
+        LimbT* rp = r;
+        LimbT c = umul1_sub<LimbT>(v, v + vn, y, rp);
+        c = usub_limb<LimbT>(r + vn, r + n + 1, c);
+        assert(!c);
+    }
+    size_t rn = n + 1;
+    while (rn && !r[rn - 1]) --rn;
+    return rn;
+}
+
+// r <- u * x + v * y, returns the size of r
+// prereqs: x, y < 2^(limb_bits - 1), r has room for max(un, vn) + 1 limbs
+template <std::unsigned_integral LimbT>
+size_t umul1_sum(LimbT const* u, size_t un, LimbT x, LimbT const* v, size_t vn, LimbT y, LimbT* r) noexcept
+{
+    const size_t n = (std::max)(un, vn);
+    if (un && x) {
+        LimbT* rp = r;
+        r[un] = umul1<LimbT>(u, u + un, x, rp);
+        std::fill(r + un + 1, r + n + 1, LimbT{ 0 });
+    } else {
+        std::fill(r, r + n + 1, LimbT{ 0 });
+    }
+    if (vn && y) {
+        LimbT* rp = r;
+        LimbT c = umul1_add<LimbT>(v, v + vn, y, rp);
+        c = uadd_limb<LimbT>(r + vn, r + n + 1, c);
+        assert(!c);
+    }
+    size_t rn = n + 1;
+    while (rn && !r[rn - 1]) --rn;
+    return rn;
+}
+
+// {u, v} -> {u', v'} by the cofactors, u' -> r0, v' -> r1, each has room for max(un, vn) + 1 limbs
+template <std::unsigned_integral LimbT>
+void lehmer_apply(LimbT const* u, size_t un, LimbT const* v, size_t vn, lehmer_cofactors<LimbT> const& cf,
+    LimbT* r0, size_t& r0n, LimbT* r1, size_t& r1n) noexcept
+{
+    if (!cf.odd) {
+        r0n = umul1_diff(u, un, cf.a, v, vn, cf.b, r0);
+        r1n = umul1_diff(v, vn, cf.d, u, un, cf.c, r1);
+    } else {
+        r0n = umul1_diff(v, vn, cf.b, u, un, cf.a, r0);
+        r1n = umul1_diff(u, un, cf.c, v, vn, cf.d, r1);
+    }
+}
+
+// u mod v -> u, u / v -> q[un - vn + 1]; returns the size of the remainder
+// prereqs: un >= vn > 0, v[vn - 1] != 0
+template <std::unsigned_integral LimbT, typename AllocatorT>
+size_t gcd_divstep(LimbT* u, size_t un, LimbT const* v, size_t vn, LimbT* q, AllocatorT& alloc)
+{
+    if (vn == 1) {
+        u[0] = udivby1<LimbT>(std::span<const LimbT>{ u, un }, v[0], std::span<LimbT>{ q, un });
+        return u[0] ? 1 : 0;
+    }
+    std::span<LimbT> ul{ u, un };
+    LimbT rh = udiv<LimbT>(LimbT{ 0 }, ul, v[vn - 1], std::span<const LimbT>{ v, vn - 1 }, q + un - vn, alloc);
+    if (ul.data() != u) std::copy(ul.begin(), ul.end(), u);
+    u[vn - 1] = rh;
+    while (vn && !u[vn - 1]) --vn;
+    return vn;
+}
+
+// the nonnegative unimodular matrix M of a reduction: {u, v} = M {u', v'}
+template <std::unsigned_integral LimbT, typename AllocatorT>
+struct hgcd_matrix
+{
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> storage;
+    size_t cap;
+    LimbT* m[2][2];
+    size_t mn[2][2];
+    LimbT* spare[2];
+    int det;
+
+    // the entries of a reduction of values of k limbs do not exceed k limbs
+    hgcd_matrix(size_t k, AllocatorT const& alloc)
+        : storage(6 * (k + 2), alloc), cap{ k + 2 }, mn{ { 1, 0 }, { 0, 1 } }, det{ 1 }
+    {
+        LimbT* p = storage.data();
+        for (auto& row : m) for (auto& e : row) { e = p; p += cap; }
+        spare[0] = p; spare[1] = p + cap;
+        m[0][0][0] = m[1][1][0] = 1;
+    }
+
+    // M <- M [[0, 1], [1, 0]]
+    void swap_columns() noexcept
+    {
+        for (int i = 0; i < 2; ++i) {
+            std::swap(m[i][0], m[i][1]);
+            std::swap(mn[i][0], mn[i][1]);
+        }
+        det = -det;
+    }
+
+    // M <- M [[d, b], [c, a]]
+    void mul(lehmer_cofactors<LimbT> const& cf) noexcept
+    {
+        for (int i = 0; i < 2; ++i) {
+            const size_t n0 = umul1_sum(m[i][0], mn[i][0], cf.d, m[i][1], mn[i][1], cf.c, spare[0]);
+            const size_t n1 = umul1_sum(m[i][0], mn[i][0], cf.b, m[i][1], mn[i][1], cf.a, spare[1]);
+            std::swap(m[i][0], spare[0]); mn[i][0] = n0;
+            std::swap(m[i][1], spare[1]); mn[i][1] = n1;
+        }
+        if (cf.odd) det = -det;
+    }
+
+    // M <- M [[q, 1], [1, 0]]
+    void mul(LimbT const* q, size_t qn, AllocatorT& alloc)
+    {
+        for (int i = 0; i < 2; ++i) {
+            LimbT* r = spare[0];
+            LimbT* re = umul_dispatch<LimbT>(m[i][0], mn[i][0], q, qn, r, alloc);
+            std::fill(re, r + cap, LimbT{ 0 });
+            LimbT c = uadd_inplace<LimbT>(r, m[i][1], m[i][1] + mn[i][1]);
+            c = uadd_limb<LimbT>(r + mn[i][1], r + cap, c);
+            assert(!c);
+            size_t rn = cap;
+            while (rn && !r[rn - 1]) --rn;
+            spare[0] = m[i][1];
+            m[i][1] = m[i][0]; mn[i][1] = mn[i][0];
+            m[i][0] = r; mn[i][0] = rn;
+        }
+        det = -det;
+    }
+
+    // M <- M M2, returns false if the product does not fit
+    bool mul(hgcd_matrix const& m2, AllocatorT& alloc)
+    {
+        size_t hn = 0;
+        for (auto const& row : m2.mn) for (size_t n : row) hn = (std::max)(hn, n);
+        for (auto const& row : mn) for (size_t n : row) hn = (std::max)(hn, n + 1);
+        hn += hn;
+        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(5 * hn, alloc);
+        LimbT* res[2][2] = { { work.data(), work.data() + hn }, { work.data() + 2 * hn, work.data() + 3 * hn } };
+        size_t resn[2][2];
+        LimbT* t = work.data() + 4 * hn;
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                LimbT* r = res[i][j];
+                std::fill(umul_dispatch<LimbT>(m[i][0], mn[i][0], m2.m[0][j], m2.mn[0][j], r, alloc), r + hn, LimbT{ 0 });
+                std::fill(umul_dispatch<LimbT>(m[i][1], mn[i][1], m2.m[1][j], m2.mn[1][j], t, alloc), t + hn, LimbT{ 0 });
+                [[maybe_unused]] LimbT c = uadd_inplace<LimbT>(r, t, t + hn);
+                assert(!c);
+                size_t rn = hn;
+                while (rn && !r[rn - 1]) --rn;
+                if (rn >= cap) return false;
+                resn[i][j] = rn;
+            }
+        }
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                std::copy(res[i][j], res[i][j] + resn[i][j], m[i][j]);
+                mn[i][j] = resn[i][j];
+            }
+        }
+        det *= m2.det;
+        return true;
+    }
+};
+
+// {u, v} <- M^-1 {u, v} = det [[m11, -m01], [-m10, m00]] {u, v} if both results are positive; returns false otherwise
+template <std::unsigned_integral LimbT, typename AllocatorT>
+bool hgcd_apply(hgcd_matrix<LimbT, AllocatorT> const& mx, LimbT* u, size_t& un, LimbT* v, size_t& vn, AllocatorT& alloc)
+{
+    size_t hn = 0;
+    for (auto const& row : mx.mn) for (size_t n : row) hn = (std::max)(hn, n);
+    const size_t n = (std::max)(un, vn), pn = n + hn;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(4 * pn, alloc);
+    LimbT* p[4] = { work.data(), work.data() + pn, work.data() + 2 * pn, work.data() + 3 * pn };
+
+    auto product = [pn, &alloc](LimbT const* x, size_t xn, LimbT const* y, size_t yn, LimbT* r) {
+        std::fill(umul_dispatch<LimbT>(x, xn, y, yn, r, alloc), r + pn, LimbT{ 0 });
+    };
+    // det (x - y) -> x, returns its size or 0 if it is not positive or longer than n limbs
+    auto difference = [pn, n, det = mx.det](LimbT* x, LimbT* y) -> size_t {
+        size_t xn = pn, yn = pn;
+        while (xn && !x[xn - 1]) --xn;
+        while (yn && !y[yn - 1]) --yn;
+        if (det < 0) { std::swap(x, y); std::swap(xn, yn); }
+        if (ucompare(x, xn, y, yn) <= 0) return 0;
+        LimbT c = usub_inplace<LimbT>(x, y, y + yn);
+        usub_limb<LimbT>(x + yn, x + xn, c);
+        while (xn && !x[xn - 1]) --xn;
+        if (xn > n) return 0;
+        if (det < 0) std::copy(x, x + xn, y);
+        return xn;
+    };
+
+    product(mx.m[1][1], mx.mn[1][1], u, un, p[0]);
+    product(mx.m[0][1], mx.mn[0][1], v, vn, p[1]);
+    const size_t rn0 = difference(p[0], p[1]);
+    if (!rn0) return false;
+    product(mx.m[0][0], mx.mn[0][0], v, vn, p[2]);
+    product(mx.m[1][0], mx.mn[1][0], u, un, p[3]);
+    const size_t rn1 = difference(p[2], p[3]);
+    if (!rn1) return false;
+
+    std::copy(p[0], p[0] + rn0, u); un = rn0;
+    std::copy(p[2], p[2] + rn1, v); vn = rn1;
+    return true;
+}
+
+// half-gcd: reduces {u, v} of at most k limbs along the quotient sequence until the smaller value has no more than
+// k / 2 + 2 limbs, {u, v}_input = M {u, v}_output; the leading parts of the values are reduced recursively and the
+// resulting matrices are applied by the subquadratic multiplication
+// u and v are scratch copies with room for k + 1 limbs; returns false if no quotient was taken
+template <std::unsigned_integral LimbT, typename AllocatorT>
+bool hgcd(LimbT* u, size_t un, LimbT* v, size_t vn, size_t k, hgcd_matrix<LimbT, AllocatorT>& mx, AllocatorT& alloc)
+{
+    const size_t s = k / 2 + 1;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(3 * (k + 1), alloc);
+    LimbT* t0 = work.data(), * t1 = t0 + k + 1, * q = t1 + k + 1;
+
+    bool progress = false;
+    for (;;) {
+        if (ucompare(u, un, v, vn) < 0) {
+            std::swap(u, v); std::swap(un, vn);
+            mx.swap_columns();
+        }
+        if (vn <= s + 1) break;
+
+        // the leading t limbs hold about t / 2 limbs of the quotient sequence
+        const size_t t = (std::min)(2 * (un - s), (k + 1) / 2);
+        if (t >= NUMETRON_HGCD_THRESHOLD && un <= vn + 1) {
+            const size_t p = un - t;
+            small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> top(2 * (t + 1), alloc);
+            LimbT* tu = top.data(), * tv = tu + t + 1;
+            std::copy(u + p, u + un, tu);
+            std::copy(v + p, v + vn, tv);
+            hgcd_matrix<LimbT, AllocatorT> m2{ t, alloc };
+            if (hgcd(tu, un - p, tv, vn - p, t, m2, alloc) && hgcd_apply(m2, u, un, v, vn, alloc)) {
+                [[maybe_unused]] bool fits = mx.mul(m2, alloc);
+                assert(fits);
+                progress = true;
+                continue;
+            }
+        }
+
+        lehmer_cofactors<LimbT> cf;
+        if (un <= vn + 1 && lehmer_step(u, un, v, vn, cf)) {
+            size_t n0, n1;
+            lehmer_apply(u, un, v, vn, cf, t0, n0, t1, n1);
+            std::swap(u, t0); un = n0;
+            std::swap(v, t1); vn = n1;
+            mx.mul(cf);
+        } else {
+            const size_t rn = gcd_divstep(u, un, v, vn, q, alloc);
+            size_t qn = un - vn + 1;
+            while (!q[qn - 1]) --qn;
+            mx.mul(q, qn, alloc);
+            std::swap(u, v);
+            un = vn; vn = rn;
+        }
+        progress = true;
+    }
+    return progress;
+}
+
+// a plain gcd tracks no cofactors
+struct gcd_no_cofactor
+{
+    static constexpr bool tracked = false;
+
+    void swap() noexcept {}
+    template <typename... ArgsT> void step(ArgsT&&...) noexcept {}
+};
+
+// the cofactors of the first operand U along a reduction of {U, V}: the current pair is
+// {a, b} = {sign u0 U + x V, -sign u1 U + y V}
+template <std::unsigned_integral LimbT, typename AllocatorT>
+struct gcd_cofactor
+{
+    static constexpr bool tracked = true;
+
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> storage;
+    size_t cap;
+    LimbT* u0, * u1, * spare[2];
+    size_t n0, n1;
+    int sign;
+
+    // the cofactors of a reduction of values of n limbs do not exceed n limbs
+    gcd_cofactor(size_t n, AllocatorT const& alloc)
+        : storage(4 * (n + 2), alloc), cap{ n + 2 }, n0{ 1 }, n1{ 0 }, sign{ 1 }
+    {
+        u0 = storage.data(); u1 = u0 + cap;
+        spare[0] = u1 + cap; spare[1] = spare[0] + cap;
+        u0[0] = 1;
+    }
+
+    void swap() noexcept
+    {
+        std::swap(u0, u1); std::swap(n0, n1);
+        sign = -sign;
+    }
+
+    // {u0, u1} <- {a u0 + b u1, c u0 + d u1}
+    void step(lehmer_cofactors<LimbT> const& cf, AllocatorT&) noexcept
+    {
+        const size_t m0 = umul1_sum(u0, n0, cf.a, u1, n1, cf.b, spare[0]);
+        const size_t m1 = umul1_sum(u0, n0, cf.c, u1, n1, cf.d, spare[1]);
+        std::swap(u0, spare[0]); n0 = m0;
+        std::swap(u1, spare[1]); n1 = m1;
+        if (cf.odd) sign = -sign;
+    }
+
+    // {u0, u1} <- {u1, u0 + q u1}
+    void step(LimbT const* q, size_t qn, AllocatorT& alloc)
+    {
+        LimbT* r = spare[0];
+        std::fill(umul_dispatch<LimbT>(q, qn, u1, n1, r, alloc), r + cap, LimbT{ 0 });
+        LimbT c = uadd_inplace<LimbT>(r, u0, u0 + n0);
+        c = uadd_limb<LimbT>(r + n0, r + cap, c);
+        assert(!c);
+        size_t rn = cap;
+        while (rn && !r[rn - 1]) --rn;
+        spare[0] = u0;
+        u0 = u1; n0 = n1;
+        u1 = r; n1 = rn;
+        sign = -sign;
+    }
+
+    // {u0, u1} <- {m11 u0 + m01 u1, m10 u0 + m00 u1}
+    void step(hgcd_matrix<LimbT, AllocatorT> const& mx, AllocatorT& alloc)
+    {
+        size_t hn = 0;
+        for (auto const& row : mx.mn) for (size_t n : row) hn = (std::max)(hn, n);
+        const size_t pn = hn + (std::max)(n0, n1);
+        small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(2 * pn, alloc);
+        LimbT* p0 = work.data(), * p1 = p0 + pn;
+        auto combine = [&](LimbT const* x, size_t xn, LimbT const* y, size_t yn, LimbT* r) {
+            std::fill(umul_dispatch<LimbT>(x, xn, u0, n0, p0, alloc), p0 + pn, LimbT{ 0 });
+            std::fill(umul_dispatch<LimbT>(y, yn, u1, n1, p1, alloc), p1 + pn, LimbT{ 0 });
+            [[maybe_unused]] LimbT c = uadd_inplace<LimbT>(p0, p1, p1 + pn);
+            assert(!c);
+            size_t rn = pn;
+            while (rn && !p0[rn - 1]) --rn;
+            assert(rn < cap);
+            std::copy(p0, p0 + rn, r);
+            return rn;
+        };
+        const size_t m0 = combine(mx.m[1][1], mx.mn[1][1], mx.m[0][1], mx.mn[0][1], spare[0]);
+        const size_t m1 = combine(mx.m[1][0], mx.mn[1][0], mx.m[0][0], mx.mn[0][0], spare[1]);
+        std::swap(u0, spare[0]); n0 = m0;
+        std::swap(u1, spare[1]); n1 = m1;
+        sign *= mx.det;
+    }
+};
+
+// reduces {a, b} to {gcd(a, b), 0} and returns the gcd; the cofactor tracker follows the steps
+// prereqs: a, b > 0, the workspace w has room for 5 n limbs, n > max(an, bn), a is stored at w, b at w + n
+template <std::unsigned_integral LimbT, typename CofactorT, typename AllocatorT>
+std::span<LimbT> ugcd_reduce(LimbT* w, size_t n, size_t an, size_t bn, CofactorT& cof, AllocatorT& alloc)
+{
+    LimbT* a = w, * b = a + n, * t0 = b + n, * t1 = t0 + n, * q = t1 + n;
+    for (;;) {
+        if (ucompare(a, an, b, bn) < 0) {
+            std::swap(a, b); std::swap(an, bn);
+            cof.swap();
+        }
+        if (!bn) break;
+        if constexpr (!CofactorT::tracked) {
+            if (bn == 1) {
+                LimbT rl = an == 1 ? a[0] % b[0] : udivby1<LimbT>(std::span<const LimbT>{ a, an }, b[0], std::span<LimbT>{ q, an });
+                a[0] = ugcd1(rl, b[0]);
+                an = 1;
+                break;
+            }
+        }
+        if (an >= NUMETRON_GCD_DC_THRESHOLD && an <= bn + 1) {
+            const size_t p = an / 2, k = an - p;
+            small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> top(2 * (k + 1), alloc);
+            LimbT* tu = top.data(), * tv = tu + k + 1;
+            std::copy(a + p, a + an, tu);
+            std::copy(b + p, b + bn, tv);
+            hgcd_matrix<LimbT, AllocatorT> mx{ k, alloc };
+            if (hgcd(tu, k, tv, bn - p, k, mx, alloc) && hgcd_apply(mx, a, an, b, bn, alloc)) {
+                cof.step(mx, alloc);
+                continue;
+            }
+        }
+        lehmer_cofactors<LimbT> cf;
+        if (an <= bn + 1 && lehmer_step(a, an, b, bn, cf)) {
+            size_t n0, n1;
+            lehmer_apply(a, an, b, bn, cf, t0, n0, t1, n1);
+            std::swap(a, t0); an = n0;
+            std::swap(b, t1); bn = n1;
+            cof.step(cf, alloc);
+        } else {
+            const size_t rn = gcd_divstep(a, an, b, bn, q, alloc);
+            if constexpr (CofactorT::tracked) {
+                size_t qn = an - bn + 1;
+                while (!q[qn - 1]) --qn;
+                cof.step(q, qn, alloc);
+            }
+            std::swap(a, b);
+            an = bn; bn = rn;
+        }
+    }
+    return { a, an };
+}
+
+// gcd(u, v) -> r, returns the size of the result
+// prereqs: r has room for max(un, vn) limbs
+template <std::unsigned_integral LimbT, typename AllocatorT>
+size_t ugcd(LimbT const* u, size_t un, LimbT const* v, size_t vn, LimbT* r, AllocatorT alloc)
+{
+    while (un && !u[un - 1]) --un;
+    while (vn && !v[vn - 1]) --vn;
+    if (!vn) { std::copy(u, u + un, r); return un; }
+    if (!un) { std::copy(v, v + vn, r); return vn; }
+
+    const size_t n = (std::max)(un, vn) + 1;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(5 * n, alloc);
+    std::copy(u, u + un, work.data());
+    std::copy(v, v + vn, work.data() + n);
+    gcd_no_cofactor cof;
+    std::span<LimbT> g = ugcd_reduce(work.data(), n, un, vn, cof, alloc);
+    std::copy(g.begin(), g.end(), r);
+    return g.size();
+}
+
+// gcd(u, v) = s u + t v -> {g, |s|, |t|}, returns the sizes of the results and the sign of s;
+// the cofactors have opposite signs, |s| <= v / g + 1, |t| <= u / g + 1
+// prereqs: g has room for max(un, vn) limbs, s for vn + 1 limbs, t for un + 1 limbs
+template <std::unsigned_integral LimbT, typename AllocatorT>
+std::tuple<size_t, size_t, size_t, int> ugcdext(LimbT const* u, size_t un, LimbT const* v, size_t vn, LimbT* g, LimbT* s, LimbT* t, AllocatorT alloc)
+{
+    while (un && !u[un - 1]) --un;
+    while (vn && !v[vn - 1]) --vn;
+    if (!vn) {
+        std::copy(u, u + un, g);
+        if (un) s[0] = 1;
+        return { un, un ? 1 : 0, 0, 1 };
+    }
+    if (!un) {
+        std::copy(v, v + vn, g);
+        t[0] = 1;
+        return { vn, 0, 1, -1 };
+    }
+
+    const size_t n = (std::max)(un, vn) + 1;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(5 * n, alloc);
+    std::copy(u, u + un, work.data());
+    std::copy(v, v + vn, work.data() + n);
+    gcd_cofactor<LimbT, AllocatorT> cof{ n, alloc };
+    std::span<LimbT> gs = ugcd_reduce(work.data(), n, un, vn, cof, alloc);
+    const size_t gn = gs.size(), sn = cof.n0;
+    const int sign = sn ? cof.sign : -1;
+    assert(sn <= vn + 1);
+    std::copy(gs.begin(), gs.end(), g);
+    std::copy(cof.u0, cof.u0 + sn, s);
+
+    // |t| = (|s| u - sign g) / v
+    const size_t pn = (std::max)(sn + un, gn) + 1;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> tbuf(2 * pn, alloc);
+    LimbT* p = tbuf.data(), * pq = p + pn;
+    std::fill(umul_dispatch<LimbT>(s, sn, u, un, p, alloc), p + pn, LimbT{ 0 });
+    if (sign > 0) {
+        usub_limb<LimbT>(p + gn, p + pn, usub_inplace<LimbT>(p, g, g + gn));
+    } else {
+        uadd_limb<LimbT>(p + gn, p + pn, uadd_inplace<LimbT>(p, g, g + gn));
+    }
+    size_t qn = pn;
+    while (qn && !p[qn - 1]) --qn;
+    if (qn < vn) return { gn, sn, 0, sign };
+    if (vn == 1) {
+        udivby1<LimbT>(std::span<const LimbT>{ p, qn }, v[0], std::span<LimbT>{ pq, qn });
+    } else {
+        std::span<LimbT> pl{ p, qn };
+        udiv<LimbT>(LimbT{ 0 }, pl, v[vn - 1], std::span<const LimbT>{ v, vn - 1 }, pq + qn - vn, alloc);
+        qn = qn - vn + 1;
+    }
+    while (qn && !pq[qn - 1]) --qn;
+    assert(qn <= un + 1);
+    std::copy(pq, pq + qn, t);
+    return { gn, sn, qn, sign };
+}
+
+// u^-1 mod m (or (-u)^-1 mod m if negative) -> r[mn], returns the size of the result or nothing if gcd(u, m) != 1
+// prereqs: m > 0
+template <std::unsigned_integral LimbT, typename AllocatorT>
+std::optional<size_t> uinvert(LimbT const* u, size_t un, bool negative, LimbT const* m, size_t mn, LimbT* r, AllocatorT alloc)
+{
+    while (un && !u[un - 1]) --un;
+    while (mn && !m[mn - 1]) --mn;
+    assert(mn);
+    if (mn == 1 && m[0] == 1) return 0; // everything is the inverse of everything modulo 1
+    if (!un) return std::nullopt;
+
+    const size_t n = (std::max)(un, mn) + 1;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(5 * n, alloc);
+    std::copy(u, u + un, work.data());
+    std::copy(m, m + mn, work.data() + n);
+    gcd_cofactor<LimbT, AllocatorT> cof{ n, alloc };
+    std::span<LimbT> g = ugcd_reduce(work.data(), n, un, mn, cof, alloc);
+    if (g.size() != 1 || g[0] != 1) return std::nullopt;
+
+    // the cofactor is reduced modulo m and negated if it (or u) is negative
+    LimbT* s = cof.u0;
+    size_t sn = cof.n0;
+    while (ucompare(s, sn, m, mn) >= 0) {
+        usub_limb<LimbT>(s + mn, s + sn, usub_inplace<LimbT>(s, m, m + mn));
+        while (sn && !s[sn - 1]) --sn;
+    }
+    if ((cof.sign < 0) != negative && sn) {
+        std::fill(s + sn, s + mn, LimbT{ 0 });
+        std::copy(m, m + mn, r);
+        usub_inplace<LimbT>(r, s, s + mn);
+        sn = mn;
+        while (sn && !r[sn - 1]) --sn;
+        return sn;
+    }
+    std::copy(s, s + sn, r);
+    return sn;
+}
+
+}
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include "uadd.hpp"
 #include "umul_basecase.hpp"
+#include "usqr_basecase.hpp"
+#include "umul_ntt.hpp"
 #include "toom/engine.hpp"
 #include "toom/thresholds.hpp"
 
@@ -29,6 +32,150 @@ inline bool is_toom3_applicable(size_t un, size_t vn) noexcept
     return vn >= NUMETRON_TOOM3_THRESHOLD && 3 * vn > un;
 }
 
+inline bool is_toom4_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_TOOM4_THRESHOLD && 4 * vn > un;
+}
+
+// Toom-6.5 covers both the 6 x 6 and the 7 x 6 split, see toom6h_split_u7()
+inline bool is_toom6h_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_TOOM6H_THRESHOLD && 7 * vn > un;
+}
+
+// true if u is split into 7 pieces: with 6 pieces the top piece of u would be longer than a chunk
+inline bool toom6h_split_u7(size_t un, size_t vn) noexcept
+{
+    return un > 6 * ((vn + 5) / 6);
+}
+
+inline bool is_toom8_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_TOOM8_THRESHOLD && 8 * vn > un;
+}
+
+// Unbalanced variants: u is split into N pieces and v into M, for un / vn around N / M.
+// Toom-4x3 covers 5/4 <= un / vn < 7/4, Toom-4x2 and Toom-3x2 the rest up to 3.
+inline bool is_toom43_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_TOOM43_THRESHOLD && 4 * un >= 5 * vn && 4 * un < 7 * vn;
+}
+
+inline bool is_toom42_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_TOOM42_THRESHOLD && 4 * un >= 7 * vn && 3 * vn > un;
+}
+
+inline bool is_toom32_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_TOOM32_THRESHOLD && 2 * un >= 3 * vn && 3 * vn > un;
+}
+
+// u longer than 3 * vn is multiplied piece by piece, see umul_chunked()
+inline bool is_chunked_mul_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_KARATSUBA_THRESHOLD && un >= 3 * vn;
+}
+
+inline bool is_sqr_karatsuba_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_SQR_KARATSUBA_THRESHOLD;
+}
+
+inline bool is_sqr_toom3_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_SQR_TOOM3_THRESHOLD;
+}
+
+inline bool is_sqr_toom4_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_SQR_TOOM4_THRESHOLD;
+}
+
+inline bool is_sqr_toom6_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_SQR_TOOM6_THRESHOLD;
+}
+
+inline bool is_sqr_toom8_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_SQR_TOOM8_THRESHOLD;
+}
+
+// {u}^2 -> rb[2 * un]
+// returns rb + 2 * un, where un is the size of u without leading zeros
+template <std::unsigned_integral LimbT, typename AllocatorT>
+inline LimbT* usqr_dispatch(
+    const LimbT* u, size_t un,
+    LimbT* rb,
+    AllocatorT alloc)
+{
+    while (un > 0 && u[un - 1] == 0) --un;
+
+    if constexpr (sizeof(LimbT) == 8) {
+        if (is_sqr_ntt_applicable(un)) {
+            return usqr_ntt(u, un, rb, std::move(alloc));
+        }
+    }
+
+    if (is_sqr_toom8_applicable(un)) {
+        return toom_sqr_engine<8>::usqr(u, un, rb, std::move(alloc));
+    }
+
+    if (is_sqr_toom6_applicable(un)) {
+        return toom_sqr_engine<6>::usqr(u, un, rb, std::move(alloc));
+    }
+
+    if (is_sqr_toom4_applicable(un)) {
+        return toom_sqr_engine<4>::usqr(u, un, rb, std::move(alloc));
+    }
+
+    if (is_sqr_toom3_applicable(un)) {
+        return toom_sqr_engine<3>::usqr(u, un, rb, std::move(alloc));
+    }
+
+    if (is_sqr_karatsuba_applicable(un)) {
+        return toom_sqr_engine<2>::usqr(u, un, rb, std::move(alloc));
+    }
+
+    if (un) {
+        if constexpr (sizeof(LimbT) == 8) {
+#if defined(NUMETRON_USE_ASM) && (defined(__x86_64__) || defined(_M_X64)) && defined(NUMETRON_PLATFORM_AUTODETECT)
+            if (is_ifma_sqr_applicable(un)) {
+                if (auto kernel = kernel_table.sqr_basecase_ifma) {
+                    kernel(rb, u, un);
+                    return rb + 2 * un;
+                }
+            }
+#endif
+            if (un >= NUMETRON_SQR_BASECASE_THRESHOLD) {
+                using alloc_traits_t = std::allocator_traits<AllocatorT>;
+                LimbT* tb = alloc_traits_t::allocate(alloc, un);
+                NUMETRON_SCOPE_EXIT([&] { alloc_traits_t::deallocate(alloc, tb, un); });
+                return usqr_basecase_split<LimbT>(u, un, rb, tb);
+            }
+            return umul_basecase<LimbT>(u, un, u, un, rb);
+        } else {
+            return usqr_basecase<LimbT>(u, un, rb);
+        }
+    }
+    return rb;
+}
+
+template <std::unsigned_integral LimbT, typename AllocatorT>
+inline LimbT* umul_chunked(
+    const LimbT* u, size_t un,
+    const LimbT* v, size_t vn,
+    LimbT* rb,
+    AllocatorT alloc);
+
 template <std::unsigned_integral LimbT, typename AllocatorT>
 inline LimbT* umul_dispatch(
     const LimbT* u, size_t un,
@@ -43,6 +190,47 @@ inline LimbT* umul_dispatch(
         std::swap(un, vn);
     }
 
+    if (u == v && un == vn) {
+        return usqr_dispatch(u, un, rb, std::move(alloc));
+    }
+
+    if constexpr (sizeof(LimbT) == 8) {
+        if (is_ntt_applicable(un, vn)) {
+            return umul_ntt(u, un, v, vn, rb, std::move(alloc));
+        }
+    }
+
+    if (is_chunked_mul_applicable(un, vn)) {
+        return umul_chunked(u, un, v, vn, rb, std::move(alloc));
+    }
+
+    if (is_toom43_applicable(un, vn)) {
+        return toom_engine<4, 3>::umul(u, un, v, vn, rb, std::move(alloc));
+    }
+
+    if (is_toom42_applicable(un, vn)) {
+        return toom_engine<4, 2>::umul(u, un, v, vn, rb, std::move(alloc));
+    }
+
+    if (is_toom32_applicable(un, vn)) {
+        return toom_engine<3, 2>::umul(u, un, v, vn, rb, std::move(alloc));
+    }
+
+    if (is_toom8_applicable(un, vn)) {
+        return toom_engine<8, 8>::umul(u, un, v, vn, rb, std::move(alloc));
+    }
+
+    if (is_toom6h_applicable(un, vn)) {
+        if (toom6h_split_u7(un, vn)) {
+            return toom_engine<7, 6>::umul(u, un, v, vn, rb, std::move(alloc));
+        }
+        return toom_engine<6, 6>::umul(u, un, v, vn, rb, std::move(alloc));
+    }
+
+    if (is_toom4_applicable(un, vn)) {
+        return toom_engine<4, 4>::umul(u, un, v, vn, rb, std::move(alloc));
+    }
+
     if (is_toom3_applicable(un, vn)) {
         return toom_engine<3, 3>::umul(u, un, v, vn, rb, std::move(alloc));
     }
@@ -60,10 +248,105 @@ inline LimbT* umul_dispatch(
     return rb;
 }
 
+// {u} * {v} -> rb[un + vn] for un >= 3 * vn
+// u is multiplied by v in pieces of 2 * vn limbs (the last one is shorter than 3 * vn), every piece product
+// goes through umul_dispatch and is accumulated into rb, so a long u does not fall back to the base case.
+// returns rb + un + vn
+template <std::unsigned_integral LimbT, typename AllocatorT>
+inline LimbT* umul_chunked(
+    const LimbT* u, size_t un,
+    const LimbT* v, size_t vn,
+    LimbT* rb,
+    AllocatorT alloc)
+{
+    assert(vn > 0 && un >= 3 * vn);
+    using alloc_traits_t = std::allocator_traits<AllocatorT>;
+
+    // umul_dispatch strips the leading zeros of a piece, the rest of its product is cleared here
+    auto mul_piece = [v, vn, &alloc](const LimbT* p, size_t pn, LimbT* r) {
+        LimbT* re = umul_dispatch(p, pn, v, vn, r, alloc);
+        std::fill(re, r + pn + vn, LimbT{ 0 });
+    };
+
+    const size_t piece = 2 * vn;
+    mul_piece(u, piece, rb);
+
+    const size_t tsz = 4 * vn;
+    LimbT* tb = alloc_traits_t::allocate(alloc, tsz);
+    NUMETRON_SCOPE_EXIT([&] { alloc_traits_t::deallocate(alloc, tb, tsz); });
+
+    for (size_t off = piece; off < un;) {
+        const size_t pn = un - off >= 3 * vn ? piece : un - off;
+        mul_piece(u + off, pn, tb);
+        // rb[off, off + vn) holds the high part of the previous piece product
+        LimbT c = uadd_inplace(rb + off, tb, tb + vn);
+        std::copy(tb + vn, tb + pn + vn, rb + off + vn);
+        c = uadd_limb(rb + off + vn, rb + off + pn + vn, c);
+        assert(!c); (void)c;
+        off += pn;
+    }
+    return rb + un + vn;
+}
+
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires(std::is_same_v<LimbT, typename std::allocator_traits<AllocatorT>::value_type>)
+inline std::tuple<LimbT*, size_t, size_t> usqr(std::span<const LimbT> u, AllocatorT alloc)
+{
+    if (!u.empty()) {
+        size_t rsz = 2 * u.size();
+        LimbT* r = std::allocator_traits<AllocatorT>::allocate(alloc, rsz);
+        NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&] { std::allocator_traits<AllocatorT>::deallocate(alloc, r, rsz); });
+        LimbT* re = usqr_dispatch(u.data(), u.size(), r, alloc);
+        while (re != r && *(re - 1) == 0) --re;
+        return { r, static_cast<size_t>(re - r), rsz };
+    }
+    return { nullptr, 0, 0 };
+}
+
 template <std::unsigned_integral LimbT, typename AllocatorT>
 requires(std::is_same_v<LimbT, typename std::allocator_traits<AllocatorT>::value_type>)
 inline std::tuple<LimbT*, size_t, size_t> umul(std::span<const LimbT> u, std::span<const LimbT> v, AllocatorT alloc)
 {
+    if (u.data() == v.data() && u.size() == v.size()) {
+        return usqr(u, std::move(alloc));
+    }
+
+    if (is_chunked_mul_applicable(u.size(), v.size()) || (sizeof(LimbT) == 8 && is_ntt_applicable(u.size(), v.size()))) {
+        size_t rsz = u.size() + v.size();
+        LimbT* r = std::allocator_traits<AllocatorT>::allocate(alloc, rsz);
+        NUMETRON_SCOPE_EXCEPTIONAL_EXIT([&] { std::allocator_traits<AllocatorT>::deallocate(alloc, r, rsz); });
+        LimbT* re = umul_dispatch(u.data(), u.size(), v.data(), v.size(), r, alloc);
+        while (re != r && *(re - 1) == 0) --re;
+        return { r, static_cast<size_t>(re - r), rsz };
+    }
+
+    if (is_toom43_applicable(u.size(), v.size())) {
+        return toom_engine<4, 3>::umul(u, v, std::move(alloc));
+    }
+
+    if (is_toom42_applicable(u.size(), v.size())) {
+        return toom_engine<4, 2>::umul(u, v, std::move(alloc));
+    }
+
+    if (is_toom32_applicable(u.size(), v.size())) {
+        return toom_engine<3, 2>::umul(u, v, std::move(alloc));
+    }
+
+    if (is_toom8_applicable(u.size(), v.size())) {
+        return toom_engine<8, 8>::umul(u, v, std::move(alloc));
+    }
+
+    if (is_toom6h_applicable(u.size(), v.size())) {
+        if (toom6h_split_u7(u.size(), v.size())) {
+            return toom_engine<7, 6>::umul(u, v, std::move(alloc));
+        }
+        return toom_engine<6, 6>::umul(u, v, std::move(alloc));
+    }
+
+    if (is_toom4_applicable(u.size(), v.size())) {
+        return toom_engine<4, 4>::umul(u, v, std::move(alloc));
+    }
+
     if (is_toom3_applicable(u.size(), v.size())) {
         return toom_engine<3, 3>::umul(u, v, std::move(alloc));
     }
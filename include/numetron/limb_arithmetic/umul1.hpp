@@ -96,6 +96,22 @@ inline LimbT umul1_add(UIteratorT ub, UIteratorT ue, LimbT v, ResultIteratorT &
 #endif
 }
 
+// (c, p[u.size()]) <- p[u.size()] - [u] * v; returns c, the result is p - [u] * v + c * B^u.size()
+template <std::unsigned_integral LimbT, typename UIteratorT, typename ResultIteratorT>
+inline LimbT umul1_sub(UIteratorT ub, UIteratorT ue, LimbT v, ResultIteratorT& r) noexcept
+{
+    LimbT c = 0;
+    for (; ub != ue; ++ub, ++r) {
+        auto [h, l] = numetron::arithmetic::umul1(*ub, v);
+        l += c;
+        h += (l < c);
+        LimbT x = *r;
+        *r = x - l;
+        c = h + (x < l);
+    }
+    return c;
+}
+
 #if 0
 
 // (uh, [ul]) * v + cl -> (rh, r[ul.size() + 1]); returns rh
@@ -15,6 +15,11 @@ inline LimbT* umul_basecase_unrolled(LimbT const* ub, LimbT const* ue, LimbT con
 {
     const auto ucnt = ue - ub;
     const auto vcnt = ve - vb;
+    if (ucnt == 1) {
+        const LimbT c = umul1<LimbT>(vb, ve, *ub, rb); // rb is advanced by vcnt
+        *rb = c;
+        return rb + 1;
+    }
     if (ucnt == 2) {
         auto [h00, l00] = arithmetic::umul1(*ub, *vb);
         *rb = l00;
@@ -244,13 +249,16 @@ inline LimbT* umul_basecase(LimbT const* ub, size_t un, LimbT const* vb, size_t
     if constexpr (sizeof(LimbT) == 8) {
 #if defined(NUMETRON_USE_ASM) && (defined(__x86_64__) || defined(_M_X64))
 #   if defined(NUMETRON_PLATFORM_AUTODETECT)
-        std::call_once(mul_basecase_init_flag, []() {
-            uint64_t platform_descriptor = numetron_detect_platform();
-            //std::cout << "PLATFROM: " << std::hex << "0x" << platform_descriptor << std::dec << std::endl;
-            __mul_basecase_ptr = detect_mul_basecase(platform_descriptor);
-        });
-        if (__mul_basecase_ptr) __mul_basecase_ptr(rb, ub, un, vb, vn);
-        return rb + un + vn;
+        if (is_ifma_mul_applicable(un, vn)) {
+            if (auto kernel = kernel_table.mul_basecase_ifma) {
+                kernel(rb, ub, un, vb, vn);
+                return rb + un + vn;
+            }
+        }
+        if (auto kernel = kernel_table.mul_basecase) [[likely]] {
+            kernel(rb, ub, un, vb, vn);
+            return rb + un + vn;
+        }
 #   else
         NUMETRON_mul_basecase(rb, ub, un, vb, vn);
         return rb + un + vn;
@@ -0,0 +1,288 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+// the AVX-512 intrinsics of GCC 12 set off -Wuninitialized on their own undefined pass-through operands
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// the AVX-512 IFMA base case takes the products of un + vn limbs from this size...
+#ifndef NUMETRON_IFMA_MUL_THRESHOLD
+#   define NUMETRON_IFMA_MUL_THRESHOLD 26
+#endif
+
+// ...where the shorter operand has at least this many limbs...
+#ifndef NUMETRON_IFMA_MUL_MIN_LIMBS
+#   define NUMETRON_IFMA_MUL_MIN_LIMBS 6
+#endif
+
+// ...and the longer one at most this many, the digit buffers live on the stack
+#ifndef NUMETRON_IFMA_MUL_MAX_LIMBS
+#   define NUMETRON_IFMA_MUL_MAX_LIMBS 128
+#endif
+
+// the AVX-512 IFMA square base case is used from this size up to NUMETRON_IFMA_MUL_MAX_LIMBS
+#ifndef NUMETRON_IFMA_SQR_THRESHOLD
+#   define NUMETRON_IFMA_SQR_THRESHOLD 10
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define NUMETRON_TARGET_AVX512IFMA __attribute__((target("avx512f,avx512ifma")))
+#else
+#   define NUMETRON_TARGET_AVX512IFMA
+#endif
+
+namespace numetron::limb_arithmetic {
+
+inline bool is_ifma_mul_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    return vn >= NUMETRON_IFMA_MUL_MIN_LIMBS && un + vn >= NUMETRON_IFMA_MUL_THRESHOLD && un <= NUMETRON_IFMA_MUL_MAX_LIMBS;
+}
+
+inline bool is_ifma_sqr_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_IFMA_SQR_THRESHOLD && un <= NUMETRON_IFMA_MUL_MAX_LIMBS;
+}
+
+namespace detail {
+
+inline constexpr uint64_t radix52_mask = (uint64_t{ 1 } << 52) - 1;
+
+// the number of 52-bit digits of an n limb number
+constexpr size_t radix52_size(size_t n) noexcept { return (64 * n + 51) / 52; }
+
+// the room for the digits of an n limb number, the conversions work by 16 digits
+constexpr size_t radix52_capacity(size_t n) noexcept { return (radix52_size(n) + 15) / 16 * 16; }
+
+inline __mmask8 radix52_limb_mask(size_t n) noexcept
+{
+    return static_cast<__mmask8>(n >= 8 ? 0xFF : (1u << n) - 1);
+}
+
+// u[un] -> d[radix52_capacity(un)] in the 2^52 radix, the digits above radix52_size(un) are zero;
+// 13 limbs are 16 digits: the digit t of the first eight starts in the limb w0[t] at the bit s0[t],
+// the digit t of the next eight in the limb 6 + w1[t] at the bit s1[t]
+NUMETRON_TARGET_AVX512IFMA
+inline void to_radix52(uint64_t const* u, size_t un, uint64_t* d) noexcept
+{
+    const __m512i w0 = _mm512_set_epi64(5, 4, 4, 3, 2, 1, 0, 0);
+    const __m512i s0 = _mm512_set_epi64(44, 56, 4, 16, 28, 40, 52, 0);
+    const __m512i w1 = _mm512_set_epi64(6, 5, 4, 3, 2, 2, 1, 0);
+    const __m512i s1 = _mm512_set_epi64(12, 24, 36, 48, 60, 8, 20, 32);
+    const __m512i one = _mm512_set1_epi64(1), bits = _mm512_set1_epi64(64);
+    const __m512i mask = _mm512_set1_epi64(static_cast<long long>(radix52_mask));
+    for (size_t i = 0; i < un; i += 13, u += 13, d += 16) {
+        const size_t rest = un - i;
+        const __m512i x0 = _mm512_maskz_loadu_epi64(radix52_limb_mask(rest), u);
+        const __m512i x1 = _mm512_maskz_loadu_epi64(radix52_limb_mask(rest > 6 ? rest - 6 : 0), u + 6);
+        // a shift by 64 yields zero, so the digits that lie within one limb take nothing from the next
+        const __m512i d0 = _mm512_or_si512(
+            _mm512_srlv_epi64(_mm512_permutexvar_epi64(w0, x0), s0),
+            _mm512_sllv_epi64(_mm512_permutexvar_epi64(_mm512_add_epi64(w0, one), x0), _mm512_sub_epi64(bits, s0)));
+        const __m512i d1 = _mm512_or_si512(
+            _mm512_srlv_epi64(_mm512_permutexvar_epi64(w1, x1), s1),
+            _mm512_sllv_epi64(_mm512_permutexvar_epi64(_mm512_add_epi64(w1, one), x1), _mm512_sub_epi64(bits, s1)));
+        _mm512_storeu_si512(d, _mm512_and_si512(d0, mask));
+        _mm512_storeu_si512(d + 8, _mm512_and_si512(d1, mask));
+    }
+}
+
+// the eight limbs that start in the digits i[m] at the bits s[m] of the 16 digits {lo, hi}, every limb takes up to
+// two more digits; the index 16 wraps around, but the digit that would be there is shifted out anyway
+NUMETRON_TARGET_AVX512IFMA
+inline __m512i radix52_pack(__m512i lo, __m512i hi, __m512i i, __m512i s) noexcept
+{
+    const __m512i i1 = _mm512_add_epi64(i, _mm512_set1_epi64(1)), i2 = _mm512_add_epi64(i, _mm512_set1_epi64(2));
+    const __m512i s1 = _mm512_sub_epi64(_mm512_set1_epi64(52), s), s2 = _mm512_sub_epi64(_mm512_set1_epi64(104), s);
+    return _mm512_or_si512(_mm512_or_si512(
+        _mm512_srlv_epi64(_mm512_permutex2var_epi64(lo, i, hi), s),
+        _mm512_sllv_epi64(_mm512_permutex2var_epi64(lo, i1, hi), s1)),
+        _mm512_sllv_epi64(_mm512_permutex2var_epi64(lo, i2, hi), s2));
+}
+
+// the digits d[16 * ceil(rn / 13)] below 2^52 -> r[rn], 16 digits are 13 limbs
+NUMETRON_TARGET_AVX512IFMA
+inline void from_radix52(uint64_t const* d, uint64_t* r, size_t rn) noexcept
+{
+    const __m512i i0 = _mm512_set_epi64(8, 7, 6, 4, 3, 2, 1, 0);
+    const __m512i s0 = _mm512_set_epi64(32, 20, 8, 48, 36, 24, 12, 0);
+    const __m512i i1 = _mm512_set_epi64(14, 14, 14, 14, 13, 12, 11, 9);
+    const __m512i s1 = _mm512_set_epi64(40, 40, 40, 40, 28, 16, 4, 44);
+    for (size_t m = 0; m < rn; m += 13, d += 16, r += 13) {
+        const size_t rest = rn - m;
+        const __m512i lo = _mm512_loadu_si512(d), hi = _mm512_loadu_si512(d + 8);
+        _mm512_mask_storeu_epi64(r, radix52_limb_mask(rest), radix52_pack(lo, hi, i0, s0));
+        if (rest > 8) {
+            _mm512_mask_storeu_epi64(r + 8, radix52_limb_mask(rest - 8) & 0x1F, radix52_pack(lo, hi, i1, s1));
+        }
+    }
+}
+
+// the column sums of a 2^52 radix product -> r[rn]: the low halves of the digit products are in lo[cn], the high
+// halves in hi[cn] one column lower; the columns are reduced to digits in place, the values above rn limbs are zero
+// prereqs: lo and hi have room for 16 * ceil(cn / 16) columns, the unused ones are zero; the sums are below 2^63
+NUMETRON_TARGET_AVX512IFMA
+inline void radix52_columns_to_limbs(uint64_t* lo, uint64_t const* hi, size_t cn, uint64_t* r, size_t rn) noexcept
+{
+    const __m512i mask = _mm512_set1_epi64(static_cast<long long>(radix52_mask));
+    // every column is split into a digit and a carry of up to 11 bits, the carry is added to the next digit,
+    // then once more for the carries of a single bit; a digit that overflows after that is rare
+    __m512i hp = _mm512_setzero_si512(), cp = _mm512_setzero_si512(), ep = _mm512_setzero_si512();
+    __mmask8 overflow = 0;
+    const size_t en = (cn + 15) / 16 * 16;
+    for (size_t k = 0; k < en; k += 8) {
+        const __m512i h = _mm512_load_si512(hi + k);
+        const __m512i x = _mm512_add_epi64(_mm512_load_si512(lo + k), _mm512_alignr_epi64(h, hp, 7));
+        const __m512i c = _mm512_srli_epi64(x, 52);
+        const __m512i y = _mm512_add_epi64(_mm512_and_si512(x, mask), _mm512_alignr_epi64(c, cp, 7));
+        const __m512i e = _mm512_srli_epi64(y, 52);
+        const __m512i z = _mm512_add_epi64(_mm512_and_si512(y, mask), _mm512_alignr_epi64(e, ep, 7));
+        overflow |= _mm512_cmpgt_epu64_mask(z, mask);
+        _mm512_store_si512(lo + k, z);
+        hp = h; cp = c; ep = e;
+    }
+    if (overflow) [[unlikely]] {
+        uint64_t carry = 0;
+        for (size_t k = 0; k < en; ++k) {
+            const uint64_t t = lo[k] + carry;
+            lo[k] = t & radix52_mask;
+            carry = t >> 52;
+        }
+    }
+    from_radix52(lo, r, rn);
+}
+
+}
+
+// {u} * {v} -> rp[un + vn] with the AVX-512 IFMA instructions: the operands are split into 52-bit digits, every
+// vpmadd52luq/vpmadd52huq pair accumulates the low and the high halves of eight digit products into eight adjacent
+// columns, the columns are reduced to digits and packed back into limbs at the end
+// prereqs: un, vn <= NUMETRON_IFMA_MUL_MAX_LIMBS, rp does not overlap u and v, the CPU supports AVX512F and
+// AVX512IFMA
+NUMETRON_TARGET_AVX512IFMA
+inline void umul_basecase_ifma(uint64_t* rp, uint64_t const* up, size_t un, uint64_t const* vp, size_t vn) noexcept
+{
+    constexpr size_t max_digits = detail::radix52_capacity(NUMETRON_IFMA_MUL_MAX_LIMBS);
+    assert(un && vn && un <= NUMETRON_IFMA_MUL_MAX_LIMBS && vn <= NUMETRON_IFMA_MUL_MAX_LIMBS);
+
+    // a is surrounded by 16 zero digits on both sides, so the loads that hang over its ends need no masks
+    alignas(64) uint64_t a[max_digits + 32];
+    alignas(64) uint64_t b[max_digits];
+    alignas(64) uint64_t lo[2 * max_digits];
+    alignas(64) uint64_t hi[2 * max_digits];
+
+    const size_t an = detail::radix52_size(un), bn = detail::radix52_size(vn);
+    _mm512_store_si512(a, _mm512_setzero_si512());
+    _mm512_store_si512(a + 8, _mm512_setzero_si512());
+    detail::to_radix52(up, un, a + 16);
+    _mm512_storeu_si512(a + 16 + an, _mm512_setzero_si512());
+    _mm512_storeu_si512(a + 24 + an, _mm512_setzero_si512());
+    detail::to_radix52(vp, vn, b);
+
+    // the columns k .. k + 15 take a[k - j .. k - j + 15] * b[j] for every j that reaches them,
+    // one broadcast of b[j] feeds two blocks of eight columns
+    const size_t cn = an + bn;
+    for (size_t k = 0; k < cn; k += 16) {
+        __m512i lo0 = _mm512_setzero_si512(), hi0 = _mm512_setzero_si512();
+        __m512i lo1 = _mm512_setzero_si512(), hi1 = _mm512_setzero_si512();
+        const size_t je = bn < k + 16 ? bn : k + 16;
+        uint64_t const* ak = a + 16 + k;
+        for (size_t j = k >= an ? k - an + 1 : 0; j < je; ++j) {
+            const __m512i bj = _mm512_set1_epi64(static_cast<long long>(b[j]));
+            const __m512i a0 = _mm512_loadu_si512(ak - j), a1 = _mm512_loadu_si512(ak - j + 8);
+            lo0 = _mm512_madd52lo_epu64(lo0, a0, bj);
+            hi0 = _mm512_madd52hi_epu64(hi0, a0, bj);
+            lo1 = _mm512_madd52lo_epu64(lo1, a1, bj);
+            hi1 = _mm512_madd52hi_epu64(hi1, a1, bj);
+        }
+        _mm512_store_si512(lo + k, lo0);
+        _mm512_store_si512(hi + k, hi0);
+        _mm512_store_si512(lo + k + 8, lo1);
+        _mm512_store_si512(hi + k + 8, hi1);
+    }
+    detail::radix52_columns_to_limbs(lo, hi, cn, rp, un + vn);
+}
+
+// {u}^2 -> rp[2 * un] with the AVX-512 IFMA instructions, the digits are laid out as in umul_basecase_ifma;
+// only the products a[i] a[j] with i > j are accumulated, the lanes of a column block that reach the diagonal are
+// masked off, then the columns are doubled and the squares a[i]^2 are added
+// prereqs: un <= NUMETRON_IFMA_MUL_MAX_LIMBS, rp does not overlap u, the CPU supports AVX512F and AVX512IFMA
+NUMETRON_TARGET_AVX512IFMA
+inline void usqr_basecase_ifma(uint64_t* rp, uint64_t const* up, size_t un) noexcept
+{
+    constexpr size_t max_digits = detail::radix52_capacity(NUMETRON_IFMA_MUL_MAX_LIMBS);
+    assert(un && un <= NUMETRON_IFMA_MUL_MAX_LIMBS);
+
+    alignas(64) uint64_t a[max_digits + 32];
+    alignas(64) uint64_t lo[2 * max_digits];
+    alignas(64) uint64_t hi[2 * max_digits];
+
+    const size_t an = detail::radix52_size(un);
+    _mm512_store_si512(a, _mm512_setzero_si512());
+    _mm512_store_si512(a + 8, _mm512_setzero_si512());
+    detail::to_radix52(up, un, a + 16);
+    _mm512_storeu_si512(a + 16 + an, _mm512_setzero_si512());
+    _mm512_storeu_si512(a + 24 + an, _mm512_setzero_si512());
+    uint64_t const* b = a + 16;
+
+    // the lane t of the columns k .. k + 15 takes a[k + t - j] * a[j] for j < k + t - j: every lane of the block
+    // for j < k / 2, the lanes above 2 j - k for the next eight j
+    const size_t cn = 2 * an;
+    for (size_t k = 0; k < cn; k += 16) {
+        __m512i lo0 = _mm512_setzero_si512(), hi0 = _mm512_setzero_si512();
+        __m512i lo1 = _mm512_setzero_si512(), hi1 = _mm512_setzero_si512();
+        uint64_t const* ak = b + k;
+        size_t j = k >= an ? k - an + 1 : 0;
+        for (; j < k / 2; ++j) {
+            const __m512i bj = _mm512_set1_epi64(static_cast<long long>(b[j]));
+            const __m512i a0 = _mm512_loadu_si512(ak - j), a1 = _mm512_loadu_si512(ak - j + 8);
+            lo0 = _mm512_madd52lo_epu64(lo0, a0, bj);
+            hi0 = _mm512_madd52hi_epu64(hi0, a0, bj);
+            lo1 = _mm512_madd52lo_epu64(lo1, a1, bj);
+            hi1 = _mm512_madd52hi_epu64(hi1, a1, bj);
+        }
+        for (; j < k / 2 + 8; ++j) {
+            const unsigned int t = static_cast<unsigned int>(2 * j - k + 1); // the first lane with k + t - j > j
+            const __mmask8 m0 = static_cast<__mmask8>(0xFFFFu << t), m1 = static_cast<__mmask8>((0xFFFFu << t) >> 8);
+            const __m512i bj = _mm512_set1_epi64(static_cast<long long>(b[j]));
+            const __m512i a0 = _mm512_loadu_si512(ak - j), a1 = _mm512_loadu_si512(ak - j + 8);
+            lo0 = _mm512_mask_madd52lo_epu64(lo0, m0, a0, bj);
+            hi0 = _mm512_mask_madd52hi_epu64(hi0, m0, a0, bj);
+            lo1 = _mm512_mask_madd52lo_epu64(lo1, m1, a1, bj);
+            hi1 = _mm512_mask_madd52hi_epu64(hi1, m1, a1, bj);
+        }
+        _mm512_store_si512(lo + k, _mm512_add_epi64(lo0, lo0));
+        _mm512_store_si512(hi + k, _mm512_add_epi64(hi0, hi0));
+        _mm512_store_si512(lo + k + 8, _mm512_add_epi64(lo1, lo1));
+        _mm512_store_si512(hi + k + 8, _mm512_add_epi64(hi1, hi1));
+    }
+
+    // a[i]^2 goes to the columns 2 i and 2 i + 1, the low and the high halves of eight squares are interleaved
+    const __m512i even = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0), odd = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+    for (size_t i = 0; i < an; i += 8) {
+        const __m512i x = _mm512_loadu_si512(b + i), z = _mm512_setzero_si512();
+        const __m512i l = _mm512_madd52lo_epu64(z, x, x), h = _mm512_madd52hi_epu64(z, x, x);
+        uint64_t* c = lo + 2 * i;
+        _mm512_store_si512(c, _mm512_add_epi64(_mm512_load_si512(c), _mm512_permutex2var_epi64(l, even, h)));
+        _mm512_store_si512(c + 8, _mm512_add_epi64(_mm512_load_si512(c + 8), _mm512_permutex2var_epi64(l, odd, h)));
+    }
+    detail::radix52_columns_to_limbs(lo, hi, cn, rp, 2 * un);
+}
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,316 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <bit>
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+
+#include "numetron/arithmetic.hpp"
+#include "numetron/detail/scope_exit.hpp"
+
+#ifndef NUMETRON_MUL_NTT_THRESHOLD
+#   define NUMETRON_MUL_NTT_THRESHOLD 12000
+#endif
+
+#ifndef NUMETRON_SQR_NTT_THRESHOLD
+#   define NUMETRON_SQR_NTT_THRESHOLD 8000
+#endif
+
+namespace numetron::limb_arithmetic {
+
+// Multiplication by number theoretic transforms over three primes p_k = c_k * 2^50 + 1 < 2^62.
+// Every 64-bit limb is one coefficient, so a coefficient of the product is below (un + vn) * 2^128,
+// which is recovered exactly from its residues by the Chinese remainder theorem (p_0 p_1 p_2 > 2^185).
+// The transform length is the next power of two >= un + vn - 1, up to 2^50.
+namespace ntt_detail {
+
+// Montgomery arithmetic modulo p < 2^62 with R = 2^64.
+// Values are kept lazily in [0, 2p), twiddle factors are fully reduced.
+struct ntt_prime
+{
+    uint64_t p;
+    uint64_t pinv;  // -p^-1 mod 2^64
+    uint64_t r2;    // 2^128 mod p
+    uint64_t g;     // primitive root
+    unsigned int max_log; // 2^max_log divides p - 1
+
+    constexpr ntt_prime(uint64_t p_, uint64_t g_, unsigned int max_log_) noexcept
+        : p{ p_ }, pinv{ 0 }, r2{ 0 }, g{ g_ }, max_log{ max_log_ }
+    {
+        uint64_t inv = p; // p * p = 1 mod 8, every Newton step doubles the number of correct bits
+        for (int i = 0; i < 5; ++i) inv *= 2 - p * inv;
+        pinv = 0 - inv;
+        uint64_t r = (0 - p) % p;
+        for (int i = 0; i < 64; ++i) {
+            r <<= 1;
+            if (r >= p) r -= p;
+        }
+        r2 = r;
+    }
+
+    // a * b / 2^64 mod p in [0, 2p), prereq: a * b < p * 2^64
+    constexpr uint64_t mul(uint64_t a, uint64_t b) const noexcept
+    {
+        auto [h, l] = arithmetic::umul1(a, b);
+        auto [mh, ml] = arithmetic::umul1(static_cast<uint64_t>(l * pinv), p);
+        (void)ml; // l + ml == 0 mod 2^64
+        return h + mh + (l != 0);
+    }
+
+    // [0, 2p) -> [0, p), a - p wraps around for a < p, so the minimum is taken without a branch
+    constexpr uint64_t reduce(uint64_t a) const noexcept { return (std::min)(a, a - p); }
+
+    constexpr uint64_t to_mont(uint64_t a) const noexcept { return reduce(mul(a, r2)); }
+    constexpr uint64_t from_mont(uint64_t a) const noexcept { return reduce(mul(a, 1)); }
+
+    constexpr uint64_t pow(uint64_t a, uint64_t e) const noexcept
+    {
+        uint64_t r = to_mont(1);
+        for (; e; e >>= 1, a = reduce(mul(a, a))) {
+            if (e & 1) r = reduce(mul(r, a));
+        }
+        return r;
+    }
+
+    // a^-1 mod p, normal form
+    constexpr uint64_t inverse(uint64_t a) const noexcept { return from_mont(pow(to_mont(a), p - 2)); }
+};
+
+inline constexpr ntt_prime ntt_primes[3] = {
+    { 0x3fdc000000000001ull, 3, 50 },
+    { 0x3ec4000000000001ull, 37, 50 },
+    { 0x3e74000000000001ull, 3, 50 }
+};
+
+// Garner's constants: x = r0 + p0 * y1 + p0 * p1 * y2
+struct ntt_crt
+{
+    uint64_t p0_inv_1;  // p0^-1 mod p1, Montgomery form
+    uint64_t p0_2;      // p0 mod p2, Montgomery form
+    uint64_t p01_inv_2; // (p0 * p1)^-1 mod p2, Montgomery form
+    uint64_t p01_lo, p01_hi;
+
+    constexpr ntt_crt() noexcept
+    {
+        constexpr ntt_prime const& P0 = ntt_primes[0];
+        constexpr ntt_prime const& P1 = ntt_primes[1];
+        constexpr ntt_prime const& P2 = ntt_primes[2];
+        p0_inv_1 = P1.to_mont(P1.inverse(P0.p % P1.p));
+        p0_2 = P2.to_mont(P0.p % P2.p);
+        uint64_t p01_2 = P2.from_mont(P2.mul(p0_2, P2.to_mont(P1.p % P2.p)));
+        p01_inv_2 = P2.to_mont(P2.inverse(p01_2));
+        auto [h, l] = arithmetic::umul1(P0.p, P1.p);
+        p01_lo = l;
+        p01_hi = h;
+    }
+};
+
+inline constexpr ntt_crt ntt_crt_constants{};
+
+// tw[h + j] = w_2h^j, j < h, for every h = 1, 2, .., n / 2 where w_2h is a root of unity of order 2h
+// (the inverse roots if inverse is set); the table occupies tw[1 .. n)
+template <typename LimbT>
+inline void ntt_roots(ntt_prime const& prime, size_t n, LimbT* tw, bool inverse) noexcept
+{
+    const ntt_prime P = prime; // a local copy: the limb stores below cannot alias it
+    assert(std::has_single_bit(n) && std::countr_zero(n) <= static_cast<int>(P.max_log));
+    uint64_t w = P.pow(P.to_mont(P.g), (P.p - 1) >> std::countr_zero(n));
+    if (inverse) w = P.pow(w, n - 1);
+    const uint64_t one = P.to_mont(1);
+    for (size_t h = n / 2; h >= 1; h /= 2) {
+        LimbT* t = tw + h;
+        t[0] = one;
+        for (size_t j = 1; j < h; ++j) t[j] = P.reduce(P.mul(t[j - 1], w));
+        w = P.reduce(P.mul(w, w));
+    }
+}
+
+// decimation in frequency, natural order in, bit-reversed order out
+template <typename LimbT>
+inline void ntt_forward(ntt_prime const& prime, LimbT* x, size_t n, LimbT const* tw) noexcept
+{
+    const ntt_prime P = prime;
+    const uint64_t p2 = 2 * P.p;
+    for (size_t h = n / 2; h >= 1; h /= 2) {
+        LimbT const* w = tw + h;
+        for (LimbT* a = x; a != x + n; a += 2 * h) {
+            LimbT* b = a + h;
+            for (size_t j = 0; j < h; ++j) {
+                uint64_t s = a[j], t = b[j];
+                uint64_t sum = s + t;
+                a[j] = (std::min)(sum, sum - p2);
+                b[j] = P.mul(s - t + p2, w[j]);
+            }
+        }
+    }
+}
+
+// decimation in time, bit-reversed order in, natural order out, not scaled by 1/n
+template <typename LimbT>
+inline void ntt_inverse(ntt_prime const& prime, LimbT* x, size_t n, LimbT const* itw) noexcept
+{
+    const ntt_prime P = prime;
+    const uint64_t p2 = 2 * P.p;
+    for (size_t h = 1; h < n; h *= 2) {
+        LimbT const* w = itw + h;
+        for (LimbT* a = x; a != x + n; a += 2 * h) {
+            LimbT* b = a + h;
+            for (size_t j = 0; j < h; ++j) {
+                uint64_t s = a[j], t = P.mul(b[j], w[j]);
+                uint64_t sum = s + t, dif = s - t + p2;
+                a[j] = (std::min)(sum, sum - p2);
+                b[j] = (std::min)(dif, dif - p2);
+            }
+        }
+    }
+}
+
+template <typename LimbT>
+inline void ntt_load(ntt_prime const& prime, LimbT const* u, size_t un, LimbT* x, size_t n) noexcept
+{
+    const ntt_prime P = prime;
+    for (size_t i = 0; i < un; ++i) x[i] = P.mul(u[i], P.r2);
+    std::fill(x + un, x + n, LimbT{ 0 });
+}
+
+// x[0 .. cn) <- x / n in normal form
+template <typename LimbT>
+inline void ntt_unload(ntt_prime const& prime, LimbT* x, size_t cn, size_t n) noexcept
+{
+    const ntt_prime P = prime;
+    const uint64_t ninv = P.inverse(n % P.p);
+    for (size_t i = 0; i < cn; ++i) x[i] = P.reduce(P.mul(x[i], ninv));
+}
+
+// rb[0 .. cn + 1) <- sum CRT(r0[i], r1[i], r2[i]) * B^i
+template <typename LimbT>
+inline void ntt_compose(LimbT const* r0, LimbT const* r1, LimbT const* r2, size_t cn, LimbT* rb) noexcept
+{
+    constexpr ntt_prime const& P0 = ntt_primes[0];
+    constexpr ntt_prime const& P1 = ntt_primes[1];
+    constexpr ntt_prime const& P2 = ntt_primes[2];
+    constexpr ntt_crt const& C = ntt_crt_constants;
+
+    uint64_t a0 = 0, a1 = 0, a2 = 0; // carried part of the result, a2 stays small
+    for (size_t i = 0; i < cn; ++i) {
+        const uint64_t x0 = r0[i], x1 = r1[i], x2 = r2[i];
+        const uint64_t x0_1 = P1.reduce(x0);
+        const uint64_t y1 = P1.reduce(P1.mul(x1 >= x0_1 ? x1 - x0_1 : x1 + P1.p - x0_1, C.p0_inv_1));
+
+        // (x0 + p0 * y1) mod p2
+        const uint64_t t = P2.reduce(P2.reduce(P2.reduce(x0) + P2.mul(y1, C.p0_2)));
+        const uint64_t y2 = P2.reduce(P2.mul(x2 >= t ? x2 - t : x2 + P2.p - t, C.p01_inv_2));
+
+        // x = x0 + p0 * y1 + p0 * p1 * y2
+        auto [h1, l1] = arithmetic::umul1(P0.p, y1);
+        auto [h2, l2] = arithmetic::umul1(C.p01_lo, y2);
+        auto [h3, l3] = arithmetic::umul1(C.p01_hi, y2);
+        unsigned char c = 0;
+        a0 = arithmetic::uadd1c(a0, x0, c);
+        a1 = arithmetic::uadd1c(a1, uint64_t{ 0 }, c);
+        a2 += c; c = 0;
+        a0 = arithmetic::uadd1c(a0, l1, c);
+        a1 = arithmetic::uadd1c(a1, h1, c);
+        a2 += c; c = 0;
+        a0 = arithmetic::uadd1c(a0, l2, c);
+        a1 = arithmetic::uadd1c(a1, h2, c);
+        a2 += c; c = 0;
+        a1 = arithmetic::uadd1c(a1, l3, c);
+        a2 += h3 + c;
+
+        rb[i] = static_cast<LimbT>(a0);
+        a0 = a1;
+        a1 = a2;
+        a2 = 0;
+    }
+    rb[cn] = static_cast<LimbT>(a0);
+    assert(!a1);
+}
+
+// rb[0 .. un + vn) <- {u} * {v}; for squaring pass v == nullptr
+template <typename LimbT, typename AllocatorT>
+inline void ntt_mul(LimbT const* u, size_t un, LimbT const* v, size_t vn, LimbT* rb, AllocatorT& alloc)
+{
+    using alloc_traits_t = std::allocator_traits<AllocatorT>;
+    const size_t cn = un + vn - 1;
+    const size_t n = (std::max)(std::bit_ceil(cn), size_t{ 2 });
+    assert(std::countr_zero(n) <= static_cast<int>(ntt_primes[0].max_log));
+
+    // three residue vectors, the transform of v and the twiddle tables
+    const size_t sz = (v ? 6 : 5) * n;
+    LimbT* buf = alloc_traits_t::allocate(alloc, sz);
+    NUMETRON_SCOPE_EXIT([&] { alloc_traits_t::deallocate(alloc, buf, sz); });
+    LimbT* tw = buf + 3 * n;
+    LimbT* itw = tw + n;
+    LimbT* y = itw + n;
+
+    for (size_t k = 0; k < 3; ++k) {
+        ntt_prime const& P = ntt_primes[k];
+        LimbT* x = buf + k * n;
+        ntt_roots(P, n, tw, false);
+        ntt_roots(P, n, itw, true);
+        ntt_load(P, u, un, x, n);
+        ntt_forward(P, x, n, tw);
+        if (v) {
+            ntt_load(P, v, vn, y, n);
+            ntt_forward(P, y, n, tw);
+            for (size_t i = 0; i < n; ++i) x[i] = P.mul(x[i], y[i]);
+        } else {
+            for (size_t i = 0; i < n; ++i) x[i] = P.mul(x[i], x[i]);
+        }
+        ntt_inverse(P, x, n, itw);
+        ntt_unload(P, x, cn, n);
+    }
+    ntt_compose(buf, buf + n, buf + 2 * n, cn, rb);
+}
+
+} // namespace ntt_detail
+
+inline bool is_ntt_applicable(size_t un, size_t vn) noexcept
+{
+    assert(un >= vn);
+    (void)un;
+    return vn >= NUMETRON_MUL_NTT_THRESHOLD;
+}
+
+inline bool is_sqr_ntt_applicable(size_t un) noexcept
+{
+    return un >= NUMETRON_SQR_NTT_THRESHOLD;
+}
+
+// {u} * {v} -> rb[un + vn]
+// Scratch of 6 * 2^ceil(log2(un + vn - 1)) limbs is taken from alloc.
+// returns rb + un + vn
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires (sizeof(LimbT) == 8)
+inline LimbT* umul_ntt(
+    const LimbT* u, size_t un,
+    const LimbT* v, size_t vn,
+    LimbT* rb,
+    AllocatorT alloc)
+{
+    assert(un > 0 && vn > 0);
+    ntt_detail::ntt_mul(u, un, v, vn, rb, alloc);
+    return rb + un + vn;
+}
+
+// {u}^2 -> rb[2 * un], u is transformed once per prime
+// returns rb + 2 * un
+template <std::unsigned_integral LimbT, typename AllocatorT>
+requires (sizeof(LimbT) == 8)
+inline LimbT* usqr_ntt(
+    const LimbT* u, size_t un,
+    LimbT* rb,
+    AllocatorT alloc)
+{
+    assert(un > 0);
+    ntt_detail::ntt_mul(u, un, static_cast<LimbT const*>(nullptr), un, rb, alloc);
+    return rb + 2 * un;
+}
+
+}
@@ -0,0 +1,55 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include "numetron/limb_arithmetic.hpp"
+#include "umul1.hpp"
+
+// the factor count below which a product is accumulated limb by limb instead of splitting the range
+#ifndef NUMETRON_PROD_BASECASE_THRESHOLD
+#   define NUMETRON_PROD_BASECASE_THRESHOLD 16
+#endif
+
+namespace numetron::limb_arithmetic {
+
+namespace detail {
+
+// f[0] * ... * f[n - 1] -> r[n], w[n] is the scratch of the same size; returns the size of the product;
+// the halves land side by side in w, so the product of two n / 2 limb halves is a single balanced multiplication
+template <std::unsigned_integral LimbT, typename AllocatorT>
+size_t uprod_tree(LimbT const* f, size_t n, LimbT* r, LimbT* w, AllocatorT& alloc)
+{
+    if (n <= NUMETRON_PROD_BASECASE_THRESHOLD) {
+        size_t rn = 1;
+        r[0] = f[0];
+        for (size_t i = 1; i < n; ++i) {
+            if (LimbT c = umul1_inplace<LimbT>(r, r + rn, f[i]); c) r[rn++] = c;
+        }
+        return rn;
+    }
+
+    const size_t h = n / 2;
+    const size_t ln = uprod_tree(f, h, w, r, alloc);
+    const size_t hn = uprod_tree(f + h, n - h, w + h, r + h, alloc);
+    LimbT* re = umul_dispatch<LimbT>(w, ln, w + h, hn, r, alloc);
+    size_t rn = static_cast<size_t>(re - r);
+    while (rn && !r[rn - 1]) --rn;
+    return rn;
+}
+
+}
+
+// the product of the nonzero single limb factors f[n] -> r; returns the size of the product
+// prereqs: n > 0, r has room for n limbs and does not overlap f
+template <std::unsigned_integral LimbT, typename AllocatorT>
+size_t uprod(LimbT const* f, size_t n, LimbT* r, AllocatorT alloc)
+{
+    assert(n);
+    if (n <= NUMETRON_PROD_BASECASE_THRESHOLD) return detail::uprod_tree(f, n, r, r, alloc);
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(n, alloc);
+    return detail::uprod_tree(f, n, r, work.data(), alloc);
+}
+
+}
@@ -0,0 +1,96 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <cassert>
+#include <limits>
+
+#include "uadd.hpp"
+#include "umul1.hpp"
+#include "umul_basecase.hpp"
+
+#ifndef NUMETRON_SQR_BASECASE_THRESHOLD
+#   define NUMETRON_SQR_BASECASE_THRESHOLD 16
+#endif
+
+namespace numetron::limb_arithmetic {
+
+// base case square: {u}^2 -> r[2 * un]
+// Only the upper triangle u[i]*u[j] (i < j) is multiplied, then it is doubled and the diagonal u[i]^2 is added,
+// that is roughly n^2/2 limb products instead of n^2.
+// returns r + 2 * un
+template <std::unsigned_integral LimbT>
+inline LimbT* usqr_basecase(LimbT const* ub, size_t un, LimbT* rb) noexcept
+{
+    assert(un > 0);
+    if (un == 1) {
+        auto [h, l] = arithmetic::umul1(*ub, *ub);
+        rb[0] = l;
+        rb[1] = h;
+        return rb + 2;
+    }
+
+    // triangle: sum u[i]*u[j]*B^(i+j), i < j -> rb[1 .. 2un - 1)
+    LimbT* r = rb + 1;
+    rb[un] = umul1<LimbT>(ub + 1, ub + un, ub[0], r);
+    for (size_t i = 1; i + 1 < un; ++i) {
+        r = rb + 2 * i + 1;
+        rb[un + i] = umul1_add<LimbT>(ub + i + 1, ub + un, ub[i], r);
+    }
+    rb[0] = 0;
+    rb[2 * un - 1] = 0;
+
+    // rb <- 2 * triangle + diagonal
+    constexpr int hbit = std::numeric_limits<LimbT>::digits - 1;
+    LimbT shifted_out = 0;
+    unsigned char c = 0;
+    for (size_t i = 0; i < un; ++i) {
+        LimbT t0 = rb[2 * i], t1 = rb[2 * i + 1];
+        auto [h, l] = arithmetic::umul1(ub[i], ub[i]);
+        rb[2 * i] = arithmetic::uadd1c(static_cast<LimbT>((t0 << 1) | shifted_out), l, c);
+        rb[2 * i + 1] = arithmetic::uadd1c(static_cast<LimbT>((t1 << 1) | (t0 >> hbit)), h, c);
+        shifted_out = t1 >> hbit;
+    }
+    assert(!c && !shifted_out);
+    return rb + 2 * un;
+}
+
+// base case square by halves: u = u0 + u1 * B^k, u^2 = u0^2 + 2 * u0 * u1 * B^k + u1^2 * B^(2k)
+// The off-diagonal block u0 * u1 is computed once by umul_basecase, so on targets where umul_basecase is
+// hand-written assembly the triangle is still multiplied by the fast kernel.
+// Below NUMETRON_SQR_BASECASE_THRESHOLD the full product is cheaper than the split bookkeeping.
+// prereq: size(tb) >= un
+// returns r + 2 * un
+template <std::unsigned_integral LimbT>
+requires (sizeof(LimbT) == 8)
+inline LimbT* usqr_basecase_split(LimbT const* ub, size_t un, LimbT* rb, LimbT* tb) noexcept
+{
+    assert(un > 0);
+    if (un < NUMETRON_SQR_BASECASE_THRESHOLD) {
+        return umul_basecase<LimbT>(ub, un, ub, un, rb);
+    }
+
+    const size_t k = un / 2;
+    usqr_basecase_split<LimbT>(ub, k, rb, tb);
+    usqr_basecase_split<LimbT>(ub + k, un - k, rb + 2 * k, tb);
+    umul_basecase<LimbT>(ub + k, un - k, ub, k, tb);
+
+    // rb[k .. 2un) += 2 * tb[0 .. un)
+    constexpr int hbit = std::numeric_limits<LimbT>::digits - 1;
+    LimbT* r = rb + k;
+    LimbT shifted_out = 0;
+    unsigned char c = 0;
+    for (size_t i = 0; i < un; ++i, ++r) {
+        LimbT t = tb[i];
+        *r = arithmetic::uadd1c(*r, static_cast<LimbT>((t << 1) | shifted_out), c);
+        shifted_out = t >> hbit;
+    }
+    LimbT cy = uadd_limb(r, rb + 2 * un, static_cast<LimbT>(c + shifted_out));
+    assert(!cy); (void)cy;
+    return rb + 2 * un;
+}
+
+}
+
@@ -0,0 +1,208 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "udiv.hpp"
+
+namespace numetron::limb_arithmetic {
+
+// true at the quadratic residues modulo P
+template <unsigned int P>
+inline constexpr std::array<bool, P> quadratic_residues = [] {
+    std::array<bool, P> result{};
+    for (unsigned int i = 0; i < P; ++i) result[i * i % P] = true;
+    return result;
+}();
+
+// false if m is not a square judging by its residues modulo 256 and modulo the factors of M = 2^(3W/4) - 1,
+// where W is the limb bitsize (2^48 - 1 = 3^2 * 5 * 7 * 13 * 17 * 97 * 241 * 257 * 673 for 64-bit limbs); no allocation
+template <std::unsigned_integral LimbT>
+[[nodiscard]] constexpr bool usquare_candidate(LimbT const* m, size_t mn) noexcept
+{
+    constexpr unsigned int qbits = std::numeric_limits<LimbT>::digits / 4;
+    constexpr LimbT M = (LimbT{ 1 } << 3 * qbits) - 1;
+
+    if (!mn) return true;
+    if (!quadratic_residues<256>[m[0] & 255]) return false;
+
+    // m mod M by Horner's rule, B = 2^qbits (mod M)
+    auto fold = [](LimbT x) -> LimbT { return (x & M) + (x >> 3 * qbits); };
+    LimbT r = 0;
+    for (size_t i = mn; i-- > 0;) {
+        r = fold(fold(static_cast<LimbT>(r << qbits)) + fold(m[i]));
+        if (r >= M) r -= M;
+    }
+
+    if constexpr (M % 9 == 0) if (!quadratic_residues<9>[r % 9]) return false;
+    if constexpr (M % 5 == 0) if (!quadratic_residues<5>[r % 5]) return false;
+    if constexpr (M % 7 == 0) if (!quadratic_residues<7>[r % 7]) return false;
+    if constexpr (M % 13 == 0) if (!quadratic_residues<13>[r % 13]) return false;
+    if constexpr (M % 17 == 0) if (!quadratic_residues<17>[r % 17]) return false;
+    if constexpr (M % 97 == 0) if (!quadratic_residues<97>[r % 97]) return false;
+    if constexpr (M % 241 == 0) if (!quadratic_residues<241>[r % 241]) return false;
+    if constexpr (M % 257 == 0) if (!quadratic_residues<257>[r % 257]) return false;
+    if constexpr (M % 673 == 0) if (!quadratic_residues<673>[r % 673]) return false;
+    return true;
+}
+
+// floor(sqrt({mh, ml})) -> s, {mh, ml} - s^2 -> {rh, rl}; returns {s, rh, rl}, rh is 0 or 1
+// prereqs: mh >= B / 4
+template <std::unsigned_integral LimbT>
+constexpr std::tuple<LimbT, LimbT, LimbT> usqrtrem2(LimbT mh, LimbT ml) noexcept
+{
+    constexpr unsigned int half = std::numeric_limits<LimbT>::digits / 2;
+    assert(mh >= (LimbT{ 1 } << (2 * half - 2)));
+
+    // (floor(sqrt(mh)) + 1) 2^half bounds the root from above, Newton's steps decrease to it;
+    // mh >= x means m / x >= B > x, so x is the root
+    LimbT x = arithmetic::sqrt(mh) + 1;
+    x = (x >> half) ? (std::numeric_limits<LimbT>::max)() : static_cast<LimbT>(x << half);
+    while (mh < x) {
+        LimbT q = arithmetic::udiv2by1<LimbT>(mh, ml, x).first;
+        LimbT y = (x >> 1) + (q >> 1) + (x & q & 1);
+        if (y >= x) break;
+        x = y;
+    }
+    auto [h, l] = arithmetic::umul1(x, x);
+    auto [b, rl] = arithmetic::usub1(ml, l);
+    return { x, static_cast<LimbT>(mh - h - b), rl };
+}
+
+// Zimmermann's Karatsuba square root: floor(sqrt(m)) -> s[n], m - s^2 -> r[n + 1]
+// prereqs: m has 2n limbs, m[2n - 1] >= B / 4
+template <std::unsigned_integral LimbT, typename AllocatorT>
+void usqrtrem_dc(LimbT const* m, size_t n, LimbT* s, LimbT* r, AllocatorT& alloc)
+{
+    if (n == 1) {
+        std::tie(s[0], r[1], r[0]) = usqrtrem2(m[1], m[0]);
+        return;
+    }
+
+    // m = a3 B^3l + a2 B^2l + a1 B^l + a0, where a3 B^l + a2 holds the 2h leading limbs
+    const size_t l = n / 2, h = n - l;
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(4 * n + 8, alloc);
+    LimbT* num = work.data(), * d = num + n + 1, * q = d + h + 1, * t = q + l + 2, * q2 = t + n + 2;
+
+    // {s', r'} = sqrtrem(a3 B^l + a2) -> {s + l, num + l}
+    LimbT* sh = s + l;
+    usqrtrem_dc(m + 2 * l, h, sh, num + l, alloc);
+
+    // {q, u} = divrem(r' B^l + a1, 2 s'), q <= B^l; u stays in num
+    std::copy(m + l, m + 2 * l, num);
+    LimbT dh = sh[h - 1];
+    d[h] = ushift_left<LimbT>(dh, std::span<const LimbT>{ sh, h - 1 }, 1, d);
+    d[h - 1] = dh;
+    std::fill(q, q + l + 2, LimbT{ 0 });
+    size_t un = n + 1;
+    while (un && !num[un - 1]) --un;
+    if (un > h) {
+        std::span<LimbT> ul{ num, un };
+        LimbT rh = udiv<LimbT>(LimbT{ 0 }, ul, d[h], std::span<const LimbT>{ d, h }, q + un - h - 1, alloc);
+        if (ul.data() != num) std::copy(ul.begin(), ul.end(), num);
+        num[h] = rh;
+        un = h + 1;
+    }
+
+    // s = s' B^l + q, the carry (q = B^l) is taken back by the correction below
+    std::copy(q, q + l, s);
+    LimbT sc = uadd_limb<LimbT>(sh, sh + h, q[l]);
+
+    // r = u B^l + a0 - q^2
+    std::fill(t, t + n + 2, LimbT{ 0 });
+    std::copy(m, m + l, t);
+    std::copy(num, num + un, t + l);
+    size_t tn = n + 2, qn = l + 1, q2n = 0;
+    while (tn && !t[tn - 1]) --tn;
+    while (qn && !q[qn - 1]) --qn;
+    if (qn) {
+        q2n = usqr_dispatch<LimbT>(q, qn, q2, alloc) - q2;
+        while (q2n && !q2[q2n - 1]) --q2n;
+    }
+    std::fill(r, r + n + 1, LimbT{ 0 });
+    if (ucompare(t, tn, q2, q2n) >= 0) {
+        LimbT c = usub_inplace<LimbT>(t, q2, q2 + q2n);
+        usub_limb<LimbT>(t + q2n, t + tn, c);
+        std::copy(t, t + (std::min)(tn, n + 1), r);
+    } else {
+        // r < 0: s - 1 -> s, r + 2 s + 1 -> r
+        LimbT c = usub_inplace<LimbT>(q2, t, t + tn);
+        usub_limb<LimbT>(q2 + tn, q2 + q2n, c);
+        while (q2n && !q2[q2n - 1]) --q2n;
+        sc -= usub_limb<LimbT>(s, s + n, LimbT{ 1 });
+        LimbT rh = s[n - 1];
+        r[n] = ushift_left<LimbT>(rh, std::span<const LimbT>{ s, n - 1 }, 1, r);
+        r[n - 1] = rh;
+        r[0] |= 1;
+        [[maybe_unused]] LimbT b = usub_inplace<LimbT>(r, q2, q2 + q2n);
+        b = usub_limb<LimbT>(r + q2n, r + n + 1, b);
+        assert(!b);
+    }
+    assert(!sc);
+}
+
+// floor(sqrt(m)) -> s, m - s^2 -> r unless r is null; returns the sizes of s and r
+// prereqs: s has room for (mn + 1) / 2 limbs, r for mn limbs
+template <std::unsigned_integral LimbT, typename AllocatorT>
+std::pair<size_t, size_t> usqrtrem(LimbT const* m, size_t mn, LimbT* s, LimbT* r, AllocatorT alloc)
+{
+    while (mn && !m[mn - 1]) --mn;
+    if (!mn) return { 0, 0 };
+    if (mn == 1) {
+        s[0] = arithmetic::sqrt(m[0]);
+        if (!r) return { 1, 0 };
+        r[0] = m[0] - s[0] * s[0];
+        return { 1, r[0] ? 1 : 0 };
+    }
+
+    // m B^pad 4^c has an even number of limbs and the leading limb >= B / 4, its root is s 2^t
+    const size_t pad = mn & 1, n = (mn + 1) / 2;
+    const unsigned int c = arithmetic::count_leading_zeros(m[mn - 1]) / 2;
+    const unsigned int t = c + (pad ? std::numeric_limits<LimbT>::digits / 2 : 0);
+    small_array<LimbT, NUMETRON_INPLACE_LIMB_RESERVE_COUNT, AllocatorT> work(4 * n + 1, alloc);
+    LimbT* mm = work.data(), * ss = mm + 2 * n, * rr = ss + n;
+    mm[0] = 0;
+    if (c) {
+        LimbT mh = m[mn - 1];
+        ushift_left<LimbT>(mh, std::span<const LimbT>{ m, mn - 1 }, 2 * c, mm + pad);
+        mm[pad + mn - 1] = mh;
+    } else {
+        std::copy(m, m + mn, mm + pad);
+    }
+    usqrtrem_dc(mm, n, ss, rr, alloc);
+
+    if (!t) {
+        std::copy(ss, ss + n, s);
+        if (!r) return { n, 0 };
+        size_t rn = n + 1;
+        while (rn && !rr[rn - 1]) --rn;
+        std::copy(rr, rr + rn, r);
+        return { n, rn };
+    }
+
+    LimbT sh = ss[n - 1];
+    ushift_right<LimbT>(sh, std::span<const LimbT>{ ss, n - 1 }, t, s);
+    s[n - 1] = sh;
+    size_t sn = n;
+    while (sn && !s[sn - 1]) --sn;
+    if (!r) return { sn, 0 };
+
+    // the remainder of the scaled root does not scale back, m - s^2 is cheaper
+    size_t s2n = usqr_dispatch<LimbT>(s, sn, mm, alloc) - mm;
+    while (s2n && !mm[s2n - 1]) --s2n;
+    std::copy(m, m + mn, r);
+    LimbT b = usub_inplace<LimbT>(r, mm, mm + s2n);
+    usub_limb<LimbT>(r + s2n, r + mn, b);
+    size_t rn = mn;
+    while (rn && !r[rn - 1]) --rn;
+    return { sn, rn };
+}
+
+}
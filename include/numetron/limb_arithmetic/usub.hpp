@@ -84,4 +84,15 @@ inline LimbT usub_unchecked(LimbT uh, std::span<const LimbT> u, LimbT vh, std::s
     return usub_unchecked<LimbT>(uh, u.data(), u.data() + u.size(), vh, v.data(), v.data() + v.size(), rb);
 }
 
+// compares the trimmed magnitudes u and v, returns -1, 0 or 1
+template <std::unsigned_integral LimbT>
+[[nodiscard]] inline int ucompare(LimbT const* u, size_t un, LimbT const* v, size_t vn) noexcept
+{
+    if (un != vn) return un < vn ? -1 : 1;
+    while (un--) {
+        if (u[un] != v[un]) return u[un] < v[un] ? -1 : 1;
+    }
+    return 0;
+}
+
 }
\ No newline at end of file
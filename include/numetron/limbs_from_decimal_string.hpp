@@ -102,12 +102,36 @@ std::expected<std::tuple<LimbT*, size_t, size_t, int>, std::exception_ptr> to_si
     get<2>(result) = max_limbs_count;
     *get<0>(result) = limb;
     get<1>(result) = 1;
+
+    // long significands collect the chunks and combine them by divide and conquer at the end
+    const bool collect_chunks = sizeof(LimbT) == 8 && max_limbs_count >= NUMETRON_SET_STR_DC_THRESHOLD;
+    std::vector<LimbT> chunks;
+    if (collect_chunks) {
+        chunks.reserve(max_limbs_count);
+        chunks.push_back(limb);
+    }
+    auto push_chunk = [&result, &chunks, collect_chunks](LimbT chunk) {
+        if (collect_chunks) {
+            chunks.push_back(chunk);
+        } else if (LimbT climb = limb_arithmetic::umul1_inplace(get<0>(result), get<0>(result) + get<1>(result), big_base, chunk); climb) {
+            *(get<0>(result) + get<1>(result)) = climb;
+            ++get<1>(result);
+        }
+    };
+
     limb = 0;
     for (size_t dc = 0;;) {
         auto [nextlimb, zcnt] = get_digit();
         if (!nextlimb) { // significand is finished
             exponent = point_pos < 0 ? zcnt : -static_cast<int64_t>(significant_digits_after_point);
             assert(dc || !limb);
+            if constexpr (sizeof(LimbT) == 8) {
+                if (collect_chunks) {
+                    auto& powers = detail::cached_radix_power_table<LimbT>(10);
+                    assert(powers.digits_per_limb() == digits_per_limb);
+                    get<1>(result) = detail::dc_set_chunks<LimbT>(chunks, powers, get<0>(result));
+                }
+            }
             if (dc) {
                 if (LimbT climb = limb_arithmetic::umul1_inplace(get<0>(result), get<0>(result) + get<1>(result), ipow<LimbT>(10, dc), limb); climb) {
                     *(get<0>(result) + get<1>(result)) = climb;
@@ -125,10 +149,7 @@ std::expected<std::tuple<LimbT*, size_t, size_t, int>, std::exception_ptr> to_si
             zcnt -= k;
             limb = limb ? limb * ipow<LimbT>(10, k) : 0;
             if (dc < digits_per_limb) break;
-            if (LimbT climb = limb_arithmetic::umul1_inplace(get<0>(result), get<0>(result) + get<1>(result), big_base, limb); climb) {
-                *(get<0>(result) + get<1>(result)) = climb;
-                ++get<1>(result);
-            }
+            push_chunk(limb);
             dc = 0;
             limb = 0;
         }
@@ -137,10 +158,7 @@ std::expected<std::tuple<LimbT*, size_t, size_t, int>, std::exception_ptr> to_si
         
         if (dc < digits_per_limb) continue;
 
-        if (LimbT climb = limb_arithmetic::umul1_inplace(get<0>(result), get<0>(result) + get<1>(result), big_base, limb); climb) {
-            *(get<0>(result) + get<1>(result)) = climb;
-            ++get<1>(result);
-        }
+        push_chunk(limb);
         dc = 0;
         limb = 0;
     }
@@ -18,6 +18,11 @@
 
 #include "limb_arithmetic/umul1.hpp"
 #include "limb_arithmetic.hpp"
+#include "radix_power_table.hpp"
+
+#ifndef NUMETRON_SET_STR_DC_THRESHOLD
+#   define NUMETRON_SET_STR_DC_THRESHOLD 100
+#endif
 
 namespace numetron::detail {
 
@@ -88,6 +93,43 @@ inline unsigned int base_guesser(std::basic_string_view<CharT>& str)
     return base;
 }
 
+// {chunks} -> r, where chunks[0] is the most significant chunk and every chunk is less than big_base
+// divide and conquer: chunks = hi * big_base^k + lo, where k is the largest power of 2 less than the chunk count
+// r must have room for chunks.size() limbs; returns the number of limbs without leading zeros
+template <std::unsigned_integral LimbT>
+size_t dc_set_chunks(std::span<const LimbT> chunks, radix_power_table<LimbT>& powers, LimbT* r)
+{
+    if (chunks.size() < NUMETRON_SET_STR_DC_THRESHOLD) {
+        size_t rn = 0;
+        for (LimbT c : chunks) {
+            if (rn) c = limb_arithmetic::umul1_inplace(r, r + rn, powers.big_base(), c);
+            if (c) r[rn++] = c;
+        }
+        return rn;
+    }
+
+    size_t i = 0;
+    while ((size_t{ 2 } << i) < chunks.size()) ++i;
+    const size_t k = size_t{ 1 } << i;
+
+    std::vector<LimbT> hi(chunks.size() - k), lo(k);
+    size_t hn = dc_set_chunks(chunks.first(chunks.size() - k), powers, hi.data());
+    size_t ln = dc_set_chunks(chunks.last(k), powers, lo.data());
+    if (!hn) {
+        std::copy(lo.data(), lo.data() + ln, r);
+        return ln;
+    }
+
+    auto const& p = powers.get(i).limbs;
+    size_t rn = hn + p.size();
+    limb_arithmetic::umul_dispatch(hi.data(), hn, p.data(), p.size(), r, std::allocator<LimbT>{});
+    LimbT c = limb_arithmetic::uadd_inplace(r, lo.data(), lo.data() + ln);
+    c = limb_arithmetic::uadd_limb(r + ln, r + rn, c);
+    assert(!c);
+    while (!r[rn - 1]) --rn;
+    return rn;
+}
+
 template <std::integral CharT>
 inline void base_prefix_skipper(std::basic_string_view<CharT>& str, unsigned int base)
 {
@@ -207,6 +249,30 @@ to_limbs(std::basic_string_view<CharT> & str, unsigned int base, int sign, Alloc
             std::get<0>(result) = alloc_traits_t::allocate(alloc, limbs_count);
             std::get<2>(result) = limbs_count;
 
+            if constexpr (sizeof(LimbT) == 8) { // the divide and conquer path needs the subquadratic multiplication
+                if (limbs_count >= NUMETRON_SET_STR_DC_THRESHOLD) {
+                    // long input: pack the digits into chunks of digits_per_limb digits, the first chunk takes the remainder,
+                    // and combine them by divide and conquer instead of folding them in one by one
+                    const CharT* pve = pc;
+                    while (pve != pce && get_digit(pve) < base) ++pve;
+                    const CharT* pd = pc - 1;
+                    size_t total_digits = static_cast<size_t>(pve - pd);
+                    std::vector<LimbT> chunks((total_digits + digits_per_limb - 1) / digits_per_limb);
+                    size_t pack_sz = total_digits - (chunks.size() - 1) * digits_per_limb;
+                    for (LimbT& chunk : chunks) {
+                        LimbT v = 0;
+                        for (; pack_sz; --pack_sz, ++pd) v = v * base + get_digit(pd);
+                        chunk = v;
+                        pack_sz = digits_per_limb;
+                    }
+                    auto& powers = detail::cached_radix_power_table<LimbT>(base);
+                    assert(powers.digits_per_limb() == digits_per_limb);
+                    std::get<1>(result) = detail::dc_set_chunks<LimbT>(chunks, powers, std::get<0>(result));
+                    str = { pve, str.data() + str.size() };
+                    return result;
+                }
+            }
+
             for (;;) {
                 auto pack_sz = (std::min)(digits_per_limb - 1, left_digits);
                 for (auto k = pack_sz; k != 0; --k, ++pc) {
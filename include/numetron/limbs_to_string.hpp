@@ -13,6 +13,11 @@
 #include "config/cmath.hpp"
 
 #include "limb_arithmetic/udiv.hpp"
+#include "radix_power_table.hpp"
+
+#ifndef NUMETRON_GET_STR_DC_THRESHOLD
+#   define NUMETRON_GET_STR_DC_THRESHOLD 20
+#endif
 
 namespace numetron {
 
@@ -85,13 +90,12 @@ OutputIteratorT bc_get_str(std::span<LimbT> limbs, int base, std::string_view al
             oi = std::copy(tempbuff, tempbuff + chars_per_limb, std::move(oi));
         }
     } else {
-        size_t chars_per_limb = size_t(std::floor(double(limb_bit_count) / std::log2(base)));
-        LimbT big_base = ipow<LimbT>(base, chars_per_limb);
-
-        int shift = count_leading_zeros(big_base);
-        int l = limb_bit_count - shift;
-        LimbT u1 = (shift ? (LimbT{ 1 } << l) : 0) - big_base;
-        auto [big_base_inverted, dummy] = udiv2by1<LimbT>(u1, 0, big_base);
+        auto& powers = detail::cached_radix_power_table<LimbT>(static_cast<unsigned int>(base));
+        const size_t chars_per_limb = powers.digits_per_limb();
+        const LimbT big_base = powers.big_base();
+        const int shift = powers.big_base_shift();
+        const int l = limb_bit_count - shift;
+        const LimbT big_base_inverted = powers.big_base_inverted();
 
         while (limbs.size() > 1) {
             LimbT r = limb_arithmetic::udivby1<LimbT>(limbs, big_base, big_base_inverted, l);
@@ -124,6 +128,100 @@ OutputIteratorT bc_get_str(std::span<LimbT> limbs, int base, std::string_view al
     return std::move(oi);
 }
 
+namespace detail {
+
+template <std::unsigned_integral LimbT, typename OutputIteratorT>
+class dc_get_str_state
+{
+public:
+    dc_get_str_state(int base, std::string_view alphabet, OutputIteratorT oi)
+        : base_{ base }, alphabet_{ alphabet }, oi_{ std::move(oi) }, powers_{ cached_radix_power_table<LimbT>(static_cast<unsigned int>(base)) }
+    {
+        leaf_buffer_.resize(NUMETRON_GET_STR_DC_THRESHOLD * std::numeric_limits<LimbT>::digits);
+    }
+
+    // writes the digits of u from low to high, padded with zeros to pad digits if pad != 0; u is destroyed
+    void convert(std::span<LimbT> u, size_t pad)
+    {
+        while (!u.empty() && !u.back()) u = u.first(u.size() - 1);
+
+        if (u.size() < NUMETRON_GET_STR_DC_THRESHOLD) {
+            convert_basecase(u, pad);
+            return;
+        }
+
+        // the largest power that is not longer than a half of u, so that u >= power and the quotient is not empty
+        size_t i = 0;
+        while (2 * powers_.get(i + 1).limbs.size() <= u.size() + 1) ++i;
+        auto const& p = powers_.get(i);
+        std::span<const LimbT> d{ p.norm };
+        if (d.size() < 2 || 2 * d.size() > u.size() + 1) { // only for tiny thresholds, the division needs a multi-limb d
+            convert_basecase(u, pad);
+            return;
+        }
+        const size_t digits = p.digits;
+
+        std::vector<LimbT> q(u.size() - d.size() + 1);
+        // the reciprocal is kept with the power, every division by it reuses one
+        LimbT const* dinv = limb_arithmetic::is_div_newton_applicable(q.size(), d.size()) ? p.inverse() : nullptr;
+        std::span<LimbT> ul = u.first(u.size() - 1);
+        LimbT rh = limb_arithmetic::udiv_dnorm<LimbT>(u.back(), ul, p.shift, d.back(), d.first(d.size() - 1), &q.back(), std::allocator<LimbT>{}, dinv);
+        u[ul.size()] = rh; // the remainder {rh, ul} takes the low d.size() limbs of u
+
+        convert(u.first(d.size()), digits);
+        convert(std::span{ q }, pad ? pad - digits : 0);
+    }
+
+    OutputIteratorT out() { return std::move(oi_); }
+
+private:
+    void convert_basecase(std::span<LimbT> u, size_t pad)
+    {
+        if (leaf_buffer_.size() < u.size() * std::numeric_limits<LimbT>::digits) {
+            leaf_buffer_.resize(u.size() * std::numeric_limits<LimbT>::digits);
+        }
+        char* e = leaf_buffer_.data();
+        if (!u.empty()) e = bc_get_str(u, base_, alphabet_, e);
+        size_t n = static_cast<size_t>(e - leaf_buffer_.data());
+        oi_ = std::copy(leaf_buffer_.data(), e, std::move(oi_));
+        for (; n < pad; ++n, ++oi_) *oi_ = alphabet_[0];
+    }
+
+    int base_;
+    std::string_view alphabet_;
+    OutputIteratorT oi_;
+    radix_power_table<LimbT>& powers_;
+    std::vector<char> leaf_buffer_;
+};
+
+}
+
+// divide and conquer conversion: u = q * base^k + r, where base^k is taken from radix_power_table
+// r is printed padded to k digits, then q; the digits are written from low to high as in bc_get_str
+// limbs are destructed during the string conversion
+template <std::unsigned_integral LimbT, typename OutputIteratorT>
+requires(!std::is_const_v<LimbT>)
+OutputIteratorT dc_get_str(std::span<LimbT> limbs, int base, std::string_view alphabet, OutputIteratorT oi)
+{
+    detail::dc_get_str_state<LimbT, OutputIteratorT> state{ base, alphabet, std::move(oi) };
+    state.convert(limbs, 0);
+    return state.out();
+}
+
+// picks the conversion by the size of the number, the digits are written from low to high
+// limbs are destructed during the string conversion
+template <std::unsigned_integral LimbT, typename OutputIteratorT>
+requires(!std::is_const_v<LimbT>)
+OutputIteratorT get_str(std::span<LimbT> limbs, int base, std::string_view alphabet, OutputIteratorT oi)
+{
+    if constexpr (sizeof(LimbT) == 8) { // the divide and conquer path needs the subquadratic multiplication
+        if (limbs.size() >= NUMETRON_GET_STR_DC_THRESHOLD) {
+            return dc_get_str(limbs, base, alphabet, std::move(oi));
+        }
+    }
+    return bc_get_str(limbs, base, alphabet, std::move(oi));
+}
+
 template <std::unsigned_integral LimbT, typename OutputIteratorT>
 OutputIteratorT to_string(std::span<LimbT> limbs, OutputIteratorT out, bool& reversed, unsigned int base = 10, std::string_view alphabet = {})
 {
@@ -133,6 +231,7 @@ OutputIteratorT to_string(std::span<LimbT> limbs, OutputIteratorT out, bool& rev
     if (base < 2 || base > (alphabet.empty() ? detail::default_alphabet_big.size() : alphabet.size())) {
         throw std::invalid_argument("wrong base");
     }
+    while (limbs.size() > 1 && !limbs.back()) limbs = limbs.first(limbs.size() - 1);
     if (limbs.empty() || (limbs.size() == 1 && !limbs.front())) {
         reversed = false;
         *out = alphabet.empty() ? '0' : alphabet[0];
@@ -183,62 +282,13 @@ OutputIteratorT to_string(std::span<LimbT> limbs, OutputIteratorT out, bool& rev
         }
     }
 
-    if (limbs.size() < 35) {
-        reversed = true;
-        if constexpr (std::is_const_v<LimbT>) {
-            std::vector<limb_type> mls( limbs.begin(), limbs.end() );
-            return bc_get_str(std::span{mls}, base, alphabet, std::move(out));
-        } else {
-            return bc_get_str(limbs, base, alphabet, std::move(out));
-        }
+    reversed = true;
+    if constexpr (std::is_const_v<LimbT>) {
+        std::vector<limb_type> mls(limbs.begin(), limbs.end());
+        return get_str(std::span{ mls }, base, alphabet, std::move(out));
     } else {
-        using namespace numetron::arithmetic;
-        namespace mpa = numetron::arithmetic;
-
-        //constexpr uint32_t limb_bit_count = std::numeric_limits<limb_type>::digits;
-
-        //size_t chars_per_limb = size_t(std::floor(double(limb_bit_count) / std::log2(base)));
-
-        std::vector<limb_type> powtab;
-        powtab.reserve(2 + limbs.size());
-
-        //limb_type logb2 = static_cast<limb_type>(std::floor(std::logl(2) / std::logl(base) * std::powl(2, limb_bit_count)));
-        //size_t ndig = umul1<limb_type>(logb2, static_cast<limb_type>(limb_bit_count * limbs.size())).first;
-        //size_t xn = 1 + ndig / chars_per_limb;
-
-        if constexpr (std::is_const_v<LimbT>) {
-            std::vector<limb_type> mls(limbs.begin(), limbs.end());
-            return bc_get_str(std::span{ mls }, base, alphabet, std::move(out));
-        } else {
-            return bc_get_str(limbs, base, alphabet, std::move(out));
-        }
-    }
-
-    /*
-    powtab_mem = new mp_limb_t[2 + un];
-    //powtab_mem = ((mp_limb_t*)__gmp_tmp_reentrant_alloc(&__tmp_marker, (un + 2 * 64) * sizeof(mp_limb_t)));
-    size_t ndig;
-    mp_size_t xn;
-    
-    ndig = umulpp(__gmpn_bases[base].logb2, std::numeric_limits<LimbT>::digits * limbs.size()).first;
-    
-    xn = 1 + ndig / __gmpn_bases[base].chars_per_limb;
-    pi = 1 + __gmpn_compute_powtab(powtab, powtab_mem, xn, base);
-    tmp = ((mp_limb_t*)__gmp_tmp_reentrant_alloc(&__tmp_marker, (((un)+64)) * sizeof(mp_limb_t)));
-    out_len = mpn_dc_get_str(str, 0, up, un, powtab + (pi - 1), tmp) - str;
-
-    delete powtab_mem[];
-    //__gmp_tmp_reentrant_free(__tmp_marker);
-    
-    return out_len;
-
-
-    if (base == 10) {
-    
+        return get_str(limbs, base, alphabet, std::move(out));
     }
-
-    return std::move(out);
-    */
 }
 
 
@@ -0,0 +1,302 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+
+#include "basic_integer.hpp"
+#include "limb_arithmetic/udiv.hpp"
+#include "limb_arithmetic/umul1.hpp"
+
+// moduli up to this size (in limbs) are exponentiated without heap allocations
+#ifndef NUMETRON_MONTGOMERY_INPLACE_LIMBS
+#   define NUMETRON_MONTGOMERY_INPLACE_LIMBS 32
+#endif
+
+namespace numetron {
+
+// Modular arithmetic for an odd modulus m of n limbs in the Montgomery form: a residue a is kept as a * R mod m,
+// R = B^n, so that a product needs a multiplication and a REDC, which replaces the division by m with n
+// multiply-add passes. Products go through umul_dispatch, so large moduli get the Toom and NTT multiplications.
+template <std::unsigned_integral LimbT, typename AllocatorT = std::allocator<LimbT>>
+class montgomery_context
+{
+    using limbs_t = std::vector<LimbT, AllocatorT>;
+    template <size_t InplaceSz> using buffer_t = detail::small_array<LimbT, InplaceSz, AllocatorT>;
+    static constexpr size_t inplace_limbs = NUMETRON_MONTGOMERY_INPLACE_LIMBS;
+
+public:
+    // the sign of m is ignored
+    explicit montgomery_context(basic_integer_view<LimbT> m, AllocatorT const& alloc = AllocatorT{})
+        : m_{ alloc }, r2_{ alloc }, one_{ alloc }
+    {
+        m.with_limbs([this](std::span<const LimbT> limbs, int) {
+            while (!limbs.empty() && !limbs.back()) limbs = limbs.first(limbs.size() - 1);
+            if (limbs.empty() || !(limbs.front() & 1)) [[unlikely]] {
+                throw std::invalid_argument("montgomery_context: the modulus must be odd");
+            }
+            m_.assign(limbs.begin(), limbs.end());
+        });
+        const size_t n = m_.size();
+        minv_ = static_cast<LimbT>(LimbT{ 0 } - limb_arithmetic::binvert1(m_.front()));
+
+        // R mod m and R^2 mod m
+        limbs_t u(2 * n + 1, 0, alloc), q(2 * n + 1, 0, alloc);
+        u[n] = 1;
+        one_.resize(n);
+        limb_arithmetic::udiv<LimbT>(std::span<const LimbT>{ u.data(), n + 1 }, m_, std::span{ q.data(), n + 1 }, one_);
+        u[n] = 0;
+        u[2 * n] = 1;
+        r2_.resize(n);
+        limb_arithmetic::udiv<LimbT>(std::span<const LimbT>{ u }, m_, std::span{ q }, r2_);
+    }
+
+    template <size_t N, typename AllocatorMT>
+    explicit montgomery_context(basic_integer<LimbT, N, AllocatorMT> const& m, AllocatorT const& alloc = AllocatorT{})
+        : montgomery_context{ (basic_integer_view<LimbT>)m, alloc }
+    {}
+
+    // the size of the modulus in limbs, every residue takes that many limbs
+    inline size_t size() const noexcept { return m_.size(); }
+
+    inline std::span<const LimbT> modulus() const noexcept { return m_; }
+
+    // t[2n] * R^-1 mod m -> r[n], t is destroyed
+    // prereqs: t < m * R
+    void redc(LimbT* t, LimbT* r) const noexcept
+    {
+        const size_t n = m_.size();
+        LimbT const* m = m_.data();
+        // every pass zeroes t[i], the carry out of the pass belongs to t[i + n] and is kept in t[i] till the end
+        for (size_t i = 0; i < n; ++i) {
+            LimbT* p = t + i;
+            t[i] = limb_arithmetic::umul1_add<LimbT>(m, m + n, static_cast<LimbT>(t[i] * minv_), p);
+        }
+        LimbT c = limb_arithmetic::uadd_inplace<LimbT>(t + n, t, t + n);
+        if (c || !less_than_modulus(t + n)) {
+            limb_arithmetic::usub_inplace<LimbT>(t + n, m, m + n);
+        }
+        std::copy(t + n, t + 2 * n, r);
+    }
+
+    // a * b * R^-1 mod m -> r, scratch takes 2n limbs; r may alias a or b
+    // prereqs: a, b < m
+    void mul(LimbT const* a, LimbT const* b, LimbT* r, LimbT* scratch) const
+    {
+        const size_t n = m_.size();
+        if (n == 1) {
+            r[0] = mul1(a[0], b[0]);
+            return;
+        }
+        LimbT* e = limb_arithmetic::umul_dispatch<LimbT>(a, n, b, n, scratch, m_.get_allocator());
+        std::fill(e, scratch + 2 * n, 0);
+        redc(scratch, r);
+    }
+
+    // a * R mod m -> r, the Montgomery form of a < m
+    void to_montgomery(LimbT const* a, LimbT* r, LimbT* scratch) const
+    {
+        mul(a, r2_.data(), r, scratch);
+    }
+
+    // a * R^-1 mod m -> r, the residue of the Montgomery form a
+    void from_montgomery(LimbT const* a, LimbT* r, LimbT* scratch) const
+    {
+        const size_t n = m_.size();
+        std::copy(a, a + n, scratch);
+        std::fill(scratch + n, scratch + 2 * n, 0);
+        redc(scratch, r);
+    }
+
+    // a * b mod m
+    template <size_t N, typename AllocatorUT>
+    [[nodiscard]] basic_integer<LimbT, N, AllocatorUT> mulm(basic_integer<LimbT, N, AllocatorUT> const& a, basic_integer_view<LimbT> b) const
+    {
+        const size_t n = m_.size();
+        buffer_t<inplace_limbs> ra(n, m_.get_allocator()), rb(n, m_.get_allocator());
+        buffer_t<2 * inplace_limbs> scratch(2 * n, m_.get_allocator());
+        residue((basic_integer_view<LimbT>)a, ra.data());
+        residue(b, rb.data());
+        // (a * b * R^-1) * R^2 * R^-1
+        mul(ra.data(), rb.data(), ra.data(), scratch.data());
+        mul(ra.data(), r2_.data(), ra.data(), scratch.data());
+        return make_integer(a, ra.data());
+    }
+
+    // base^exp mod m, exp >= 0
+    template <size_t N, typename AllocatorUT>
+    [[nodiscard]] basic_integer<LimbT, N, AllocatorUT> powm(basic_integer<LimbT, N, AllocatorUT> const& base, basic_integer_view<LimbT> exp) const
+    {
+        if (exp.is_negative()) [[unlikely]] {
+            throw std::invalid_argument("powm: negative exponent");
+        }
+        const size_t n = m_.size();
+        buffer_t<inplace_limbs> x(n, m_.get_allocator());
+        residue((basic_integer_view<LimbT>)base, x.data());
+        exp.with_limbs([this, &x](std::span<const LimbT> e, int) {
+            while (!e.empty() && !e.back()) e = e.first(e.size() - 1);
+            powm(x.data(), e, x.data());
+        });
+        return make_integer(base, x.data());
+    }
+
+    // a^e mod m -> r for the residue a < m, r may alias a
+    void powm(LimbT const* a, std::span<const LimbT> e, LimbT* r) const
+    {
+        constexpr size_t limb_bits = std::numeric_limits<LimbT>::digits;
+        const size_t n = m_.size();
+        if (e.empty()) {
+            // a^0 = 1, which is 0 for m = 1
+            buffer_t<2 * inplace_limbs> scratch(2 * n, m_.get_allocator());
+            from_montgomery(one_.data(), r, scratch.data());
+            return;
+        }
+
+        const size_t ebits = e.size() * limb_bits - numetron::arithmetic::count_leading_zeros(e.back());
+        const size_t k = window_size(ebits);
+
+        // the odd powers a, a^3, ..., a^(2^k - 1) in the Montgomery form
+        const size_t tsize = size_t{ 1 } << (k - 1);
+        buffer_t<16 * inplace_limbs> table(tsize * n, m_.get_allocator());
+        buffer_t<2 * inplace_limbs> scratch(2 * n, m_.get_allocator());
+        buffer_t<inplace_limbs> x(n, m_.get_allocator());
+        LimbT* t = table.data();
+        to_montgomery(a, t, scratch.data());
+        if (tsize > 1) {
+            mul(t, t, x.data(), scratch.data()); // a^2
+            for (size_t i = 1; i < tsize; ++i) {
+                mul(t + (i - 1) * n, x.data(), t + i * n, scratch.data());
+            }
+        }
+
+        auto bit = [e](size_t i) { return (e[i / limb_bits] >> (i % limb_bits)) & 1; };
+        auto bits = [e](size_t i, size_t len) { // len <= k < limb_bits
+            LimbT v = e[i / limb_bits] >> (i % limb_bits);
+            if (i % limb_bits + len > limb_bits) v |= e[i / limb_bits + 1] << (limb_bits - i % limb_bits);
+            return static_cast<size_t>(v & ((LimbT{ 1 } << len) - 1));
+        };
+
+        // left to right sliding window, the first window starts at the top bit
+        bool first = true;
+        for (size_t i = ebits; i;) {
+            if (!bit(i - 1)) {
+                mul(x.data(), x.data(), x.data(), scratch.data());
+                --i;
+                continue;
+            }
+            size_t j = i > k ? i - k : 0;
+            while (!bit(j)) ++j;
+            LimbT const* g = t + (bits(j, i - j) >> 1) * n;
+            if (first) {
+                std::copy(g, g + n, x.data());
+                first = false;
+            } else {
+                for (size_t s = j; s < i; ++s) {
+                    mul(x.data(), x.data(), x.data(), scratch.data());
+                }
+                mul(x.data(), g, x.data(), scratch.data());
+            }
+            i = j;
+        }
+        from_montgomery(x.data(), r, scratch.data());
+    }
+
+private:
+    static size_t window_size(size_t ebits) noexcept
+    {
+        if (ebits <= 7) return 1;
+        if (ebits <= 25) return 2;
+        if (ebits <= 81) return 3;
+        if (ebits <= 241) return 4;
+        if (ebits <= 673) return 5;
+        return 6;
+    }
+
+    // the one-limb modulus: the product and the REDC fit two limbs
+    LimbT mul1(LimbT a, LimbT b) const noexcept
+    {
+        const LimbT m = m_.front();
+        auto [h, l] = numetron::arithmetic::umul1(a, b);
+        auto [mh, ml] = numetron::arithmetic::umul1(static_cast<LimbT>(l * minv_), m);
+        auto [cl, sl] = numetron::arithmetic::uadd1(l, ml); // sl == 0
+        auto [ch, sh] = numetron::arithmetic::uadd1(h, mh);
+        auto [ch2, r] = numetron::arithmetic::uadd1(sh, static_cast<LimbT>(cl));
+        (void)sl;
+        return (ch || ch2 || r >= m) ? static_cast<LimbT>(r - m) : r;
+    }
+
+    bool less_than_modulus(LimbT const* a) const noexcept
+    {
+        for (size_t i = m_.size(); i--;) {
+            if (a[i] != m_[i]) return a[i] < m_[i];
+        }
+        return false;
+    }
+
+    // |v| mod m, or m - (|v| mod m) for a negative v -> r[n]
+    void residue(basic_integer_view<LimbT> v, LimbT* r) const
+    {
+        const size_t n = m_.size();
+        v.with_limbs([this, r, n](std::span<const LimbT> limbs, int sign) {
+            while (!limbs.empty() && !limbs.back()) limbs = limbs.first(limbs.size() - 1);
+            std::fill(r, r + n, 0);
+            if (limbs.size() < n || (limbs.size() == n && less_than_modulus(limbs.data()))) {
+                std::copy(limbs.begin(), limbs.end(), r);
+            } else {
+                buffer_t<inplace_limbs> q(limbs.size(), m_.get_allocator());
+                limb_arithmetic::udiv<LimbT>(limbs, m_, q.span(), std::span{ r, n });
+            }
+            if (sign < 0 && std::any_of(r, r + n, [](LimbT l) { return !!l; })) {
+                buffer_t<inplace_limbs> t(n, m_.get_allocator());
+                std::copy(m_.begin(), m_.end(), t.data());
+                limb_arithmetic::usub_inplace<LimbT>(t.data(), r, r + n);
+                std::copy(t.data(), t.data() + n, r);
+            }
+        });
+    }
+
+    template <size_t N, typename AllocatorUT>
+    static basic_integer<LimbT, N, AllocatorUT> make_integer(basic_integer<LimbT, N, AllocatorUT> const& proto, LimbT const* limbs, size_t n)
+    {
+        while (n && !limbs[n - 1]) --n;
+        return proto.build_new([limbs, n](auto& ih) {
+            if (!n) {
+                ih.init_zero();
+                return;
+            }
+            auto alloc = ih.inplace_allocator();
+            std::tuple<LimbT*, size_t, size_t, int> result{ alloc.allocate(n), n, n, 1 };
+            std::copy(limbs, limbs + n, get<0>(result));
+            ih.init(result);
+        });
+    }
+
+    template <size_t N, typename AllocatorUT>
+    basic_integer<LimbT, N, AllocatorUT> make_integer(basic_integer<LimbT, N, AllocatorUT> const& proto, LimbT const* limbs) const
+    {
+        return make_integer(proto, limbs, m_.size());
+    }
+
+    limbs_t m_;
+    limbs_t r2_;  // R^2 mod m
+    limbs_t one_; // R mod m, the Montgomery form of 1
+    LimbT minv_;  // -m^-1 mod B
+};
+
+// base^exp mod m for an odd m
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+[[nodiscard]] basic_integer<LimbT, N, AllocatorT> powm(basic_integer<LimbT, N, AllocatorT> const& base, basic_integer_view<LimbT> exp, basic_integer_view<LimbT> m)
+{
+    return montgomery_context<LimbT>{ m }.powm(base, exp);
+}
+
+template <std::unsigned_integral LimbT, size_t N, size_t EN, size_t MN, typename AllocatorT, typename AllocatorET, typename AllocatorMT>
+[[nodiscard]] basic_integer<LimbT, N, AllocatorT> powm(basic_integer<LimbT, N, AllocatorT> const& base, basic_integer<LimbT, EN, AllocatorET> const& exp, basic_integer<LimbT, MN, AllocatorMT> const& m)
+{
+    return powm(base, (basic_integer_view<LimbT>)exp, (basic_integer_view<LimbT>)m);
+}
+
+}
@@ -0,0 +1,395 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <tuple>
+#include <algorithm>
+
+#include "basic_integer.hpp"
+#include "montgomery.hpp"
+
+// the odd primes below this bound are tried as divisors before the probable prime test
+#ifndef NUMETRON_TRIAL_DIVISION_BOUND
+#   define NUMETRON_TRIAL_DIVISION_BOUND 1024
+#endif
+
+namespace numetron::detail {
+
+constexpr bool is_small_prime(unsigned int p) noexcept
+{
+    if (p < 2) return false;
+    for (unsigned int d = 2; d * d <= p; ++d) {
+        if (!(p % d)) return false;
+    }
+    return true;
+}
+
+// The odd primes below the trial division bound, grouped so that the product of a group fits in a limb. A group keeps
+// its product shifted up to the top bit with the reciprocal for the division by an invariant integer: the residue
+// modulo the shifted product is still a residue modulo every prime of the group.
+template <std::unsigned_integral LimbT>
+struct small_prime_table
+{
+    static constexpr unsigned int bound = static_cast<unsigned int>((std::min<uintmax_t>)(NUMETRON_TRIAL_DIVISION_BOUND, (std::numeric_limits<LimbT>::max)()));
+
+    static constexpr size_t count = [] {
+        size_t result = 0;
+        for (unsigned int p = 3; p < bound; p += 2) result += is_small_prime(p);
+        return result;
+    }();
+
+    static constexpr std::array<unsigned int, count> primes = [] {
+        std::array<unsigned int, count> result{};
+        size_t i = 0;
+        for (unsigned int p = 3; p < bound; p += 2) {
+            if (is_small_prime(p)) result[i++] = p;
+        }
+        return result;
+    }();
+
+    struct group
+    {
+        LimbT d, v;         // the normalized product and its reciprocal
+        size_t first, last; // the range of the primes
+    };
+
+    template <typename F>
+    static constexpr void for_each_group(F const& f)
+    {
+        for (size_t first = 0; first < count;) {
+            LimbT product = primes[first];
+            size_t last = first + 1;
+            for (; last < count && product <= (std::numeric_limits<LimbT>::max)() / primes[last]; ++last) product *= primes[last];
+            f(product, first, last);
+            first = last;
+        }
+    }
+
+    static constexpr size_t group_count = [] {
+        size_t result = 0;
+        for_each_group([&result](LimbT, size_t, size_t) { ++result; });
+        return result;
+    }();
+
+    static constexpr std::array<group, group_count> groups = [] {
+        std::array<group, group_count> result{};
+        size_t i = 0;
+        for_each_group([&result, &i](LimbT product, size_t first, size_t last) {
+            const LimbT d = product << arithmetic::count_leading_zeros(product);
+            // floor((B^2 - 1) / d) - B
+            result[i++] = group{ d, arithmetic::udiv2by1<LimbT>(static_cast<LimbT>(~d), static_cast<LimbT>(~LimbT{ 0 }), d).first, first, last };
+        });
+        return result;
+    }();
+};
+
+// u mod p -> r[i] for the primes p of small_prime_table; u is read once, every limb advances all of the independent
+// chains of divisions by the group products
+// prereqs: u is not empty
+template <std::unsigned_integral LimbT>
+void small_prime_residues(std::span<const LimbT> u, unsigned int* r) noexcept
+{
+    using table_t = small_prime_table<LimbT>;
+    std::array<LimbT, table_t::group_count> gr;
+    for (size_t g = 0; g < table_t::group_count; ++g) {
+        const LimbT d = table_t::groups[g].d;
+        gr[g] = u.back() >= d ? static_cast<LimbT>(u.back() - d) : u.back();
+    }
+    for (size_t i = u.size() - 1; i-- > 0;) {
+        for (size_t g = 0; g < table_t::group_count; ++g) {
+            LimbT q;
+            arithmetic::udiv2by1<LimbT>(q, gr[g], gr[g], u[i], table_t::groups[g].d, table_t::groups[g].v);
+        }
+    }
+    for (size_t g = 0; g < table_t::group_count; ++g) {
+        for (size_t k = table_t::groups[g].first; k < table_t::groups[g].last; ++k) {
+            r[k] = static_cast<unsigned int>(gr[g] % table_t::primes[k]);
+        }
+    }
+}
+
+// the Jacobi symbol (a / m), m is odd
+constexpr int jacobi(uintmax_t a, uintmax_t m) noexcept
+{
+    int result = 1;
+    a %= m;
+    while (a) {
+        while (!(a & 1)) {
+            a >>= 1;
+            if ((m & 7) == 3 || (m & 7) == 5) result = -result;
+        }
+        std::swap(a, m);
+        if ((a & 3) == 3 && (m & 3) == 3) result = -result;
+        a %= m;
+    }
+    return m == 1 ? result : 0;
+}
+
+// The Baillie-PSW test of an odd n without small factors: the strong probable prime test to base 2 and the strong
+// Lucas test with Selfridge's parameters. Residues are kept in the Montgomery form of the context.
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+class probable_prime_test
+{
+    using integer_t = basic_integer<LimbT, N, AllocatorT>;
+    using buffer_t = small_array<LimbT, NUMETRON_MONTGOMERY_INPLACE_LIMBS, AllocatorT>;
+
+public:
+    explicit probable_prime_test(integer_t const& n)
+        : n_{ n }, ctx_{ n, n.allocator() }, one_(ctx_.size(), n.allocator()), minus_one_(ctx_.size(), n.allocator()), scratch_(2 * ctx_.size(), n.allocator())
+    {
+        LimbT const* m = ctx_.modulus().data();
+        set_small(1, one_.data());
+        ctx_.to_montgomery(one_.data(), one_.data(), scratch_.data());
+        std::copy(m, m + size(), minus_one_.data());
+        limb_arithmetic::usub_inplace<LimbT>(minus_one_.data(), one_.data(), one_.data() + size());
+    }
+
+    inline size_t size() const noexcept { return ctx_.size(); }
+
+    // the strong probable prime test to base a: n - 1 = d 2^s, a^d = 1 or a^(d 2^r) = -1 for some r < s
+    // prereqs: 1 < a < n - 1
+    bool strong_fermat(LimbT a)
+    {
+        integer_t nm1 = n_ - 1;
+        const size_t s = trailing_zeros(nm1);
+        integer_t d = nm1 >> s;
+        buffer_t x(size(), n_.allocator());
+        set_small(a, x.data());
+        ((basic_integer_view<LimbT>)d).with_limbs([this, &x](std::span<const LimbT> e, int) {
+            ctx_.powm(x.data(), e, x.data());
+        });
+        ctx_.to_montgomery(x.data(), x.data(), scratch_.data());
+        if (equal(x.data(), one_.data()) || equal(x.data(), minus_one_.data())) return true;
+        for (size_t r = 1; r < s; ++r) {
+            ctx_.mul(x.data(), x.data(), x.data(), scratch_.data());
+            if (equal(x.data(), minus_one_.data())) return true;
+            if (equal(x.data(), one_.data())) return false;
+        }
+        return false;
+    }
+
+    // the strong Lucas test with P = 1, Q = (1 - D) / 4 for the first D of 5, -7, 9, -11, ... with (D / n) = -1:
+    // n + 1 = d 2^s, U_d = 0 or V_(d 2^r) = 0 for some r < s
+    bool strong_lucas()
+    {
+        // no D exists for a square, the search is stopped by the check once it takes a while
+        long long D = 5;
+        for (;; D = D > 0 ? -(D + 2) : -D + 2) {
+            const uintmax_t ad = static_cast<uintmax_t>(D > 0 ? D : -D);
+            int j = ((basic_integer_view<LimbT>)n_).with_limbs([ad, D](std::span<const LimbT> nl, int) {
+                while (!nl.back()) nl = nl.first(nl.size() - 1);
+                // (|D| / n) = (n / |D|) unless both are 3 mod 4, (-1 / n) = -1 for n = 3 mod 4
+                const uintmax_t nr = limb_arithmetic::umod1<LimbT>(nl, static_cast<LimbT>(ad));
+                int result = jacobi(nr, ad);
+                if ((ad & 3) == 3 && (nl.front() & 3) == 3) result = -result;
+                if (D < 0 && (nl.front() & 3) == 3) result = -result;
+                return result;
+            });
+            if (!j) return false; // n has no factors below the trial division bound, so |D| < n
+            if (j < 0) break;
+            if (D == 13 && is_perfect_square(n_)) return false;
+        }
+
+        const size_t n = size();
+        buffer_t q(n, n_.allocator()), v(n, n_.allocator()), v1(n, n_.allocator()), qk(n, n_.allocator()), t(n, n_.allocator());
+        const long long Q = (1 - D) / 4;
+        set_small(static_cast<LimbT>(Q < 0 ? -Q : Q), q.data());
+        if (Q < 0) negm(q.data());
+        ctx_.to_montgomery(q.data(), q.data(), scratch_.data());
+
+        integer_t np1 = n_ + 1;
+        const size_t s = trailing_zeros(np1);
+        integer_t d = np1 >> s;
+
+        // V_k, V_(k + 1), Q^k from k = 0 along the bits of d: V_2k = V_k^2 - 2 Q^k, V_(2k + 1) = V_k V_(k + 1) - P Q^k
+        addm(one_.data(), one_.data(), v.data());
+        std::copy(one_.data(), one_.data() + n, v1.data());
+        std::copy(one_.data(), one_.data() + n, qk.data());
+        ((basic_integer_view<LimbT>)d).with_limbs([&](std::span<const LimbT> e, int) {
+            constexpr size_t limb_bits = std::numeric_limits<LimbT>::digits;
+            while (!e.back()) e = e.first(e.size() - 1);
+            for (size_t i = e.size() * limb_bits - arithmetic::count_leading_zeros(e.back()); i-- > 0;) {
+                ctx_.mul(v.data(), v1.data(), t.data(), scratch_.data());
+                subm(t.data(), qk.data(), t.data());
+                if ((e[i / limb_bits] >> (i % limb_bits)) & 1) {
+                    std::copy(t.data(), t.data() + n, v.data());
+                    ctx_.mul(qk.data(), q.data(), t.data(), scratch_.data());
+                    sqr_sub2(v1.data(), t.data());
+                    ctx_.mul(qk.data(), qk.data(), qk.data(), scratch_.data());
+                    ctx_.mul(qk.data(), q.data(), qk.data(), scratch_.data());
+                } else {
+                    std::copy(t.data(), t.data() + n, v1.data());
+                    sqr_sub2(v.data(), qk.data());
+                    ctx_.mul(qk.data(), qk.data(), qk.data(), scratch_.data());
+                }
+            }
+        });
+
+        // D U_d = 2 V_(d + 1) - P V_d
+        addm(v1.data(), v1.data(), t.data());
+        if (equal(t.data(), v.data()) || is_zero(v.data())) return true;
+        for (size_t r = 1; r < s; ++r) {
+            sqr_sub2(v.data(), qk.data());
+            if (is_zero(v.data())) return true;
+            ctx_.mul(qk.data(), qk.data(), qk.data(), scratch_.data());
+        }
+        return false;
+    }
+
+private:
+    static size_t trailing_zeros(integer_t const& x)
+    {
+        return ((basic_integer_view<LimbT>)x).with_limbs([](std::span<const LimbT> l, int) {
+            size_t i = 0;
+            while (!l[i]) ++i;
+            return i * std::numeric_limits<LimbT>::digits + std::countr_zero(l[i]);
+        });
+    }
+
+    void set_small(LimbT a, LimbT* r) const noexcept
+    {
+        std::fill(r, r + size(), LimbT{ 0 });
+        r[0] = a;
+    }
+
+    bool equal(LimbT const* a, LimbT const* b) const noexcept { return std::equal(a, a + size(), b); }
+
+    bool is_zero(LimbT const* a) const noexcept { return std::all_of(a, a + size(), [](LimbT l) { return !l; }); }
+
+    bool less_than_modulus(LimbT const* a) const noexcept
+    {
+        LimbT const* m = ctx_.modulus().data();
+        for (size_t i = size(); i--;) {
+            if (a[i] != m[i]) return a[i] < m[i];
+        }
+        return false;
+    }
+
+    // a + b mod n -> r
+    void addm(LimbT const* a, LimbT const* b, LimbT* r) const noexcept
+    {
+        LimbT const* m = ctx_.modulus().data();
+        if (r != a) std::copy(a, a + size(), r);
+        LimbT c = limb_arithmetic::uadd_inplace<LimbT>(r, b, b + size());
+        if (c || !less_than_modulus(r)) limb_arithmetic::usub_inplace<LimbT>(r, m, m + size());
+    }
+
+    // a - b mod n -> r
+    void subm(LimbT const* a, LimbT const* b, LimbT* r) const noexcept
+    {
+        LimbT const* m = ctx_.modulus().data();
+        if (r != a) std::copy(a, a + size(), r);
+        if (limb_arithmetic::usub_inplace<LimbT>(r, b, b + size())) limb_arithmetic::uadd_inplace<LimbT>(r, m, m + size());
+    }
+
+    // n - a -> a for a != 0
+    void negm(LimbT* a) const noexcept
+    {
+        LimbT const* m = ctx_.modulus().data();
+        LimbT b = 0;
+        for (size_t i = 0; i < size(); ++i) {
+            std::tie(b, a[i]) = arithmetic::usub1c(m[i], a[i], b);
+        }
+    }
+
+    // v^2 - 2 w -> v
+    void sqr_sub2(LimbT* v, LimbT const* w)
+    {
+        ctx_.mul(v, v, v, scratch_.data());
+        subm(v, w, v);
+        subm(v, w, v);
+    }
+
+    integer_t const& n_;
+    montgomery_context<LimbT, AllocatorT> ctx_;
+    buffer_t one_, minus_one_; // the Montgomery forms of 1 and -1
+    buffer_t scratch_;
+};
+
+}
+
+namespace numetron {
+
+// true if |n| is a probable prime: trial division by the small primes, then the Baillie-PSW test, which has no known
+// counterexamples, followed by reps - 24 strong probable prime tests to pseudorandom bases if reps > 24;
+// the answer is exact below 2^64
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+bool is_probable_prime(basic_integer<LimbT, N, AllocatorT> const& n, unsigned int reps = 25)
+{
+    using table_t = detail::small_prime_table<LimbT>;
+    using integer_t = basic_integer<LimbT, N, AllocatorT>;
+
+    integer_t m = n.sgn() < 0 ? -n : n;
+    const int trial = ((basic_integer_view<LimbT>)m).with_limbs([](std::span<const LimbT> ml, int) {
+        while (!ml.empty() && !ml.back()) ml = ml.first(ml.size() - 1);
+        if (ml.empty()) return 0;
+        if (!(ml.front() & 1)) return ml.size() == 1 && ml.front() == 2 ? 1 : 0;
+        if (ml.size() == 1 && ml.front() == 1) return 0;
+        std::array<unsigned int, table_t::count> r;
+        detail::small_prime_residues<LimbT>(ml, r.data());
+        for (size_t i = 0; i < table_t::count; ++i) {
+            if (!r[i]) return ml.size() == 1 && ml.front() == table_t::primes[i] ? 1 : 0;
+        }
+        // no factor below the bound
+        if (ml.size() == 1 && ml.front() / table_t::bound < table_t::bound) return 1;
+        return -1;
+    });
+    if (trial >= 0) return !!trial;
+
+    detail::probable_prime_test<LimbT, N, AllocatorT> test{ m };
+    if (!test.strong_fermat(2) || !test.strong_lucas()) return false;
+
+    // the bases are below n - 1: n has more than one limb or is above the square of the bound
+    const LimbT base_bound = test.size() > 1 ? (std::numeric_limits<LimbT>::max)() : static_cast<LimbT>(static_cast<LimbT>(m) - 3);
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (unsigned int i = 24; i < reps; ++i) {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        if (!test.strong_fermat(static_cast<LimbT>(3 + static_cast<LimbT>(seed >> 11) % base_bound))) return false;
+    }
+    return true;
+}
+
+// the least prime > n; the candidates are sieved by the small primes in windows, the survivors go to the Baillie-PSW test
+template <std::unsigned_integral LimbT, size_t N, typename AllocatorT>
+basic_integer<LimbT, N, AllocatorT> next_prime(basic_integer<LimbT, N, AllocatorT> const& n)
+{
+    using table_t = detail::small_prime_table<LimbT>;
+    using integer_t = basic_integer<LimbT, N, AllocatorT>;
+    constexpr unsigned int window = 2048; // odd candidates
+
+    if (n < 2) return integer_t{ 2, n.allocator() };
+    integer_t c = n + 1;
+    if (!(c & 1u)) c += 1;
+    if (c < uint64_t{ table_t::bound } * table_t::bound) {
+        while (!is_probable_prime(c)) c += 2;
+        return c;
+    }
+
+    // c + 2j is divisible by p for j = -c / 2 (mod p)
+    std::array<unsigned int, table_t::count> r;
+    ((basic_integer_view<LimbT>)c).with_limbs([&r](std::span<const LimbT> cl, int) {
+        while (!cl.back()) cl = cl.first(cl.size() - 1);
+        detail::small_prime_residues<LimbT>(cl, r.data());
+    });
+    for (;;) {
+        std::array<bool, window> composite{};
+        for (size_t i = 0; i < table_t::count; ++i) {
+            const unsigned int p = table_t::primes[i];
+            for (size_t j = (p - r[i]) % p * ((p + 1) / 2) % p; j < window; j += p) composite[j] = true;
+        }
+        for (unsigned int j = 0; j < window; ++j) {
+            if (composite[j]) continue;
+            integer_t candidate = c + 2 * j;
+            detail::probable_prime_test<LimbT, N, AllocatorT> test{ candidate };
+            if (test.strong_fermat(2) && test.strong_lucas()) return candidate;
+        }
+        c += 2 * window;
+        for (size_t i = 0; i < table_t::count; ++i) r[i] = (r[i] + 2 * window) % table_t::primes[i];
+    }
+}
+
+}
@@ -0,0 +1,139 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+
+#include <concepts>
+#include <limits>
+#include <array>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cmath>
+
+#include "arithmetic.hpp"
+#include "limb_arithmetic.hpp"
+#include "limb_arithmetic/umul.hpp"
+#include "limb_arithmetic/udiv.hpp"
+
+namespace numetron::detail {
+
+// Powers big_base^(2^i), i = 0, 1, ..., where big_base = base^digits_per_limb is the largest power of base
+// that fits a limb. The divide and conquer radix conversions split numbers at these powers:
+// to_string divides by them, to_limbs multiplies by them. The table grows lazily by squaring.
+// get() may be called concurrently: the grown entries are never moved or changed, the growth is serialized.
+template <std::unsigned_integral LimbT>
+class radix_power_table
+{
+public:
+    struct power
+    {
+        std::vector<LimbT> limbs; // without leading zeros
+        std::vector<LimbT> norm;  // limbs << shift, the divisor form the division works with
+        int shift;                // leading zero bits of limbs.back()
+        size_t digits;            // digits_per_limb * 2^i
+
+        // the reciprocal of norm (see limb_arithmetic::uinv) for the Newton division, computed on the first request
+        LimbT const* inverse() const
+        {
+            std::call_once(inv_once_, [this] {
+                inv_.resize(norm.size());
+                limb_arithmetic::uinv<LimbT>(norm.data(), norm.size(), inv_.data(), std::allocator<LimbT>{});
+            });
+            return inv_.data();
+        }
+
+    private:
+        mutable std::vector<LimbT> inv_;
+        mutable std::once_flag inv_once_;
+    };
+
+    explicit radix_power_table(unsigned int base)
+        : base_{ base }
+        , digits_per_limb_{ static_cast<size_t>(double(std::numeric_limits<LimbT>::digits) / std::log2(double(base))) }
+        , big_base_{ arithmetic::ipow<LimbT>(static_cast<LimbT>(base), static_cast<unsigned int>(digits_per_limb_)) }
+    {
+        // the inverse of big_base for the base case conversion, see udivby1
+        big_base_shift_ = arithmetic::count_leading_zeros(big_base_);
+        const int l = std::numeric_limits<LimbT>::digits - big_base_shift_;
+        LimbT u1 = (big_base_shift_ ? (LimbT{ 1 } << l) : 0) - big_base_;
+        big_base_inverted_ = arithmetic::udiv2by1<LimbT>(u1, 0, big_base_).first;
+
+        set(powers_[0], { big_base_ }, digits_per_limb_);
+        size_.store(1, std::memory_order_release);
+    }
+
+    radix_power_table(radix_power_table const&) = delete;
+    radix_power_table& operator=(radix_power_table const&) = delete;
+
+    unsigned int base() const noexcept { return base_; }
+    size_t digits_per_limb() const noexcept { return digits_per_limb_; }
+    LimbT big_base() const noexcept { return big_base_; }
+    int big_base_shift() const noexcept { return big_base_shift_; }
+    LimbT big_base_inverted() const noexcept { return big_base_inverted_; }
+
+    // big_base^(2^i)
+    power const& get(size_t i)
+    {
+        if (i < size_.load(std::memory_order_acquire)) [[likely]] {
+            return powers_[i];
+        }
+        std::lock_guard lock{ mutex_ };
+        for (size_t sz = size_.load(std::memory_order_relaxed); sz <= i; ++sz) {
+            auto const& p = powers_[sz - 1].limbs;
+            std::vector<LimbT> sq(2 * p.size());
+            limb_arithmetic::usqr_dispatch(p.data(), p.size(), sq.data(), std::allocator<LimbT>{});
+            while (!sq.back()) sq.pop_back();
+            set(powers_[sz], std::move(sq), 2 * powers_[sz - 1].digits);
+            size_.store(sz + 1, std::memory_order_release);
+        }
+        return powers_[i];
+    }
+
+private:
+    static void set(power& p, std::vector<LimbT> limbs, size_t digits)
+    {
+        p.shift = arithmetic::count_leading_zeros(limbs.back());
+        p.norm = limbs;
+        if (p.shift) {
+            limb_arithmetic::ushift_left<LimbT>(std::span{ p.norm }, static_cast<unsigned int>(p.shift));
+        }
+        p.limbs = std::move(limbs);
+        p.digits = digits;
+    }
+
+    unsigned int base_;
+    size_t digits_per_limb_;
+    LimbT big_base_;
+    int big_base_shift_;
+    LimbT big_base_inverted_;
+
+    std::array<power, std::numeric_limits<size_t>::digits> powers_;
+    std::atomic<size_t> size_{ 0 };
+    std::mutex mutex_;
+};
+
+// The process wide table for the base, created on the first use and kept until the exit, so that
+// consecutive conversions in the same base do not rebuild the powers. The common bases are found without locking.
+template <std::unsigned_integral LimbT>
+radix_power_table<LimbT>& cached_radix_power_table(unsigned int base)
+{
+    static constexpr unsigned int direct_bases = 64;
+    static std::array<std::atomic<radix_power_table<LimbT>*>, direct_bases> direct{};
+    static std::mutex mutex;
+    static std::map<unsigned int, std::unique_ptr<radix_power_table<LimbT>>> tables;
+
+    if (base < direct_bases) {
+        if (auto* t = direct[base].load(std::memory_order_acquire); t) [[likely]] return *t;
+    }
+    std::lock_guard lock{ mutex };
+    auto& t = tables[base];
+    if (!t) t = std::make_unique<radix_power_table<LimbT>>(base);
+    if (base < direct_bases) direct[base].store(t.get(), std::memory_order_release);
+    return *t;
+}
+
+}
@@ -75,6 +75,9 @@ CheckVals MACRO label, vals:VARARG
 ENDM
 
 ; returns (0- AMD, 10000h- Intel, 20000h - Atom, 30000h- VIA, FFFF - Unknown) + family * 0x100 + model
+; in the low 32 bits and the feature flags above them:
+;   bit 32 - AVX512F and AVX512IFMA are supported and the OS saves the ZMM state
+;   bit 33 - AVX2 is supported and the OS saves the YMM state
 numetron_detect_platform PROC
     push rbx
     push rcx
@@ -83,6 +86,7 @@ numetron_detect_platform PROC
     ; Check vendor
     xor rax, rax
     cpuid
+    mov r10d, eax       ; the highest standard leaf
     
     ; ebx = vendor[0..3]
     ; edx = vendor[4..7]
@@ -172,7 +176,38 @@ atom_detected:
     jmp done
 
 done:
-    mov eax, r9d
+    ; the upper half of r9 is zero, the feature flags go there
+    cmp r10d, 7
+    jb features_done
+    mov eax, 1
+    cpuid
+    bt ecx, 27          ; OSXSAVE
+    jnc features_done
+    xor ecx, ecx
+    xgetbv
+    mov r11d, eax       ; XCR0
+    mov eax, 7
+    xor ecx, ecx
+    cpuid
+    mov eax, r11d
+    and eax, 06h        ; the SSE and AVX states are enabled
+    cmp eax, 06h
+    jne features_done
+    bt ebx, 5           ; AVX2
+    jnc avx2_done
+    bts r9, 33
+
+avx2_done:
+    and r11d, 0E6h      ; the SSE, AVX, opmask and ZMM states are enabled
+    cmp r11d, 0E6h
+    jne features_done
+    and ebx, 210000h    ; AVX512F (bit 16), AVX512IFMA (bit 21)
+    cmp ebx, 210000h
+    jne features_done
+    bts r9, 32
+
+features_done:
+    mov rax, r9
     pop rdx
     pop rcx
     pop rbx
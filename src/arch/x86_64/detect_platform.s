@@ -64,6 +64,9 @@
 #6	    BD	    Meteor Lake	    Meteor Lake
 
 # returns (0- AMD, 10000h- Intel, 20000h - Atom, 30000h- VIA, FFFF - Unknown) + family * 0x100 + model
+# in the low 32 bits and the feature flags above them:
+#   bit 32 - AVX512F and AVX512IFMA are supported and the OS saves the ZMM state
+#   bit 33 - AVX2 is supported and the OS saves the YMM state
 numetron_detect_platform:
     push %rbx
     push %rcx
@@ -72,6 +75,7 @@ numetron_detect_platform:
     # Check vendor
     xor %rax, %rax
     cpuid
+    mov %eax, %r10d       #  the highest standard leaf
     
     #  ebx = vendor[0..3]
     #  edx = vendor[4..7]
@@ -186,7 +190,37 @@ numetron_detect_platform:
     jmp .Ldone
 
 .Ldone:
-    mov %r9d, %eax
+    # the upper half of r9 is zero, the feature flags go there
+    cmp $7, %r10d
+    jb .Lfeatures_done
+    mov $1, %eax
+    cpuid
+    bt $27, %ecx          #  OSXSAVE
+    jnc .Lfeatures_done
+    xor %ecx, %ecx
+    xgetbv
+    mov %eax, %r11d       #  XCR0
+    mov $7, %eax
+    xor %ecx, %ecx
+    cpuid
+    mov %r11d, %eax
+    and $0x06, %eax       #  the SSE and AVX states are enabled
+    cmp $0x06, %eax
+    jne .Lfeatures_done
+    bt $5, %ebx           #  AVX2
+    jnc 2f
+    bts $33, %r9
+2:
+    and $0xE6, %r11d      #  the SSE, AVX, opmask and ZMM states are enabled
+    cmp $0xE6, %r11d
+    jne .Lfeatures_done
+    and $0x210000, %ebx   #  AVX512F (bit 16), AVX512IFMA (bit 21)
+    cmp $0x210000, %ebx
+    jne .Lfeatures_done
+    bts $32, %r9
+
+.Lfeatures_done:
+    mov %r9, %rax
     pop %rdx
     pop %rcx
     pop %rbx
@@ -7,6 +7,7 @@
 #include "numetron/basic_integer.hpp"
 
 #include <vector>
+#include <random>
 #include <iostream>
 
 namespace numetron {
@@ -262,6 +263,89 @@ void basic_integer_test0()
         CHECK((x0 * x0) > 24);
         //CHECK_EQUAL(pow("340282366920938463408034375210639556610"_bi, 0xf), "94971145180789141173792039356877348546615710136820159429620005475820741373484440733711065254441078508238038934605050990664553807873876669074305644271758756235065228100642097755554173541883690838600982589611688150716320040505871847239934643409009493854662453165945031933545041297089845350845567778753783952870388913863486884966424088583811509592259257648204772815239748003247381690020399370551715721516812596449220997661037663386512666647739896418940688124424283266194059250293267995087980181863547749199304889944124217666383500994250505363539943187173672572952901000000000000000"_bi);
     }
+    // the compound operators update an allocated value in place and agree with the binary operators
+    {
+        std::mt19937_64 rng{ 11 };
+        bint_t acc = "-123456789012345678901234567890123456789012345678901234567890"_bi;
+        bint_t ref = acc;
+        for (int i = 0; i < 2000; ++i) {
+            int64_t small = static_cast<int64_t>(rng());
+            bint_t big = bint_t{ static_cast<int64_t>(rng()) } * bint_t{ rng() } * bint_t{ rng() };
+            unsigned int sh = static_cast<unsigned int>(rng() % 130);
+            switch (rng() % 7) {
+            case 0: acc += small; ref = ref + small; break;
+            case 1: acc -= small; ref = ref - small; break;
+            case 2: acc += big; ref = ref + big; break;
+            case 3: acc -= big; ref = ref - big; break;
+            case 4: acc *= static_cast<int32_t>(small); ref = ref * static_cast<int32_t>(small); break;
+            case 5: acc <<= sh; ref = ref << sh; break;
+            case 6: acc >>= sh; ref = ref >> sh; break;
+            }
+            CHECK_EQUAL(acc, ref);
+            if (acc.size() > 8) {
+                acc >>= 256u;
+                ref = ref >> 256u;
+            }
+        }
+
+        // the storage is reused while the value fits
+        bint_t sum = "0x1000000000000000000000000000000000000000000000000"_bi;
+        sum -= 1;
+        auto [limbs, mask, sign] = sum.decompose();
+        for (uint64_t i = 0; i < 1000; ++i) sum += i;
+        for (uint64_t i = 0; i < 1000; ++i) sum -= i;
+        sum *= 3u;
+        sum <<= 1u;
+        sum >>= 1u;
+        CHECK(get<0>(sum.decompose()).data() == limbs.data());
+        CHECK_EQUAL(sum, "0x2fffffffffffffffffffffffffffffffffffffffffffffffd"_bi);
+
+        // an operand aliasing the value
+        bint_t x = "0xffffffffffffffffffffffffffffffffffffffff"_bi;
+        x += x;
+        CHECK_EQUAL(x, "0x1fffffffffffffffffffffffffffffffffffffffe"_bi);
+        x -= x;
+        CHECK(!x);
+        CHECK(x.sgn() == 0);
+    }
+
+    // addmul/submul agree with acc + b * c and acc - b * c for inplaced and allocated accumulators,
+    // short and long multipliers and results that change the sign
+    {
+        std::mt19937_64 rng{ 12 };
+        auto random = [&rng](size_t n) {
+            std::vector<uint64_t> l(n);
+            for (auto& x : l) x = rng();
+            return bint_t{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ l }, (rng() & 1) ? 1 : -1 } };
+        };
+        for (size_t an : { 1, 3, 40 }) {
+            for (size_t bn : { 1, 2, 5, 30 }) {
+                for (size_t cn : { 1, 2, 3, 30 }) {
+                    bint_t acc = random(an), b = random(bn), c = random(cn);
+                    bint_t ref = acc + b * c;
+                    CHECK_EQUAL(addmul(acc, b, c), ref);
+                    ref = ref - b * c;
+                    CHECK_EQUAL(submul(acc, b, c), ref);
+                    ref = ref - c * b;
+                    CHECK_EQUAL(acc.submul(c, b), ref);
+                }
+            }
+            bint_t acc = random(an), b = random(7);
+            int64_t m = static_cast<int64_t>(rng());
+            bint_t ref = acc + b * m;
+            CHECK_EQUAL(addmul(acc, b, m), ref);
+            ref = ref - b * 12345u;
+            CHECK_EQUAL(submul(acc, b, 12345u), ref);
+        }
+
+        // the exact cancellation and the operands referring to the accumulator
+        bint_t acc = "0x100000000000000000000000000000000000000000000000000000000"_bi, b = "0x10000000000000000000000000000"_bi;
+        CHECK(!submul(acc, b, b));
+        acc = "-0x123456789abcdef0123456789abcdef0123456789abcdef"_bi;
+        bint_t ref = acc + acc * acc;
+        CHECK_EQUAL(addmul(acc, acc, acc), ref);
+    }
+
     bint_t val = -65536;
     CHECK(val == -65536);
     CHECK(val < -65535);
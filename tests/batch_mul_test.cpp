@@ -0,0 +1,73 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/batch_mul.hpp"
+
+namespace numetron {
+
+void batch_mul_test()
+{
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+    std::mt19937_64 rng{ 0xBA7C };
+
+    // the lane-parallel kernels up to NUMETRON_BATCH_MUL_MAX_LIMBS, the counts leave tails of every length
+    for (size_t limbs = 1; limbs <= NUMETRON_BATCH_MUL_MAX_LIMBS + 2; ++limbs) {
+        for (size_t count : { 1, 3, 4, 7, 8, 9, 15, 64, 259 }) {
+            std::vector<uint64_t> a(limbs * count), b(limbs * count), r(2 * limbs * count);
+            for (auto& l : a) l = rng() % 4 ? rng() : ~uint64_t{ 0 };
+            for (auto& l : b) l = rng() % 4 ? rng() : ~uint64_t{ 0 };
+            batch_mul<uint64_t>(a, b, limbs, count, r);
+
+            std::vector<uint64_t> u(limbs), v(limbs), ref(2 * limbs);
+            for (size_t k = 0; k < count; ++k) {
+                for (size_t i = 0; i < limbs; ++i) {
+                    u[i] = a[i * count + k];
+                    v[i] = b[i * count + k];
+                }
+                mpn_mul_n(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()),
+                    reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)limbs);
+                for (size_t i = 0; i < 2 * limbs; ++i) CHECK(r[i * count + k] == ref[i]);
+            }
+        }
+    }
+
+    // 32-bit limbs go through the portable base case, two of them make a 64-bit limb of the same batch
+    const size_t count = 21;
+    std::vector<uint64_t> a(count), b(count), r(2 * count);
+    std::vector<uint32_t> a32(2 * count), b32(2 * count), r32(4 * count);
+    for (size_t k = 0; k < count; ++k) {
+        a[k] = k % 3 ? rng() : ~uint64_t{ 0 };
+        b[k] = k % 5 ? rng() : ~uint64_t{ 0 };
+        a32[k] = static_cast<uint32_t>(a[k]);
+        a32[count + k] = static_cast<uint32_t>(a[k] >> 32);
+        b32[k] = static_cast<uint32_t>(b[k]);
+        b32[count + k] = static_cast<uint32_t>(b[k] >> 32);
+    }
+    batch_mul<uint64_t>(a, b, 1, count, r);
+    batch_mul<uint32_t>(a32, b32, 2, count, r32);
+    for (size_t k = 0; k < count; ++k) {
+        for (size_t i = 0; i < 2; ++i) {
+            CHECK(r32[2 * i * count + k] == static_cast<uint32_t>(r[i * count + k]));
+            CHECK(r32[(2 * i + 1) * count + k] == static_cast<uint32_t>(r[i * count + k] >> 32));
+        }
+    }
+
+    r.resize(4 * count - 1);
+    a.resize(2 * count);
+    b.resize(2 * count);
+    EXPECT_THROW(batch_mul<uint64_t>(a, b, 2, count, r), std::invalid_argument);
+}
+
+}
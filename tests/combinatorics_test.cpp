@@ -0,0 +1,72 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <string>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+#include "numetron/combinatorics.hpp"
+
+namespace numetron {
+
+namespace {
+
+std::string mpz_to_string(mpz_t const z)
+{
+    std::string s(mpz_sizeinbase(z, 10) + 2, '\0');
+    mpz_get_str(s.data(), 10, z);
+    s.resize(std::strlen(s.c_str()));
+    return s;
+}
+
+}
+
+void combinatorics_test()
+{
+    mpz_t z;
+    mpz_init(z);
+
+    // the sizes cross the basecase of the product tree and reach the Toom and NTT multiplications
+    for (unsigned long n : { 0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 20ul, 21ul, 33ul, 100ul, 257ul, 1000ul, 4097ul, 30000ul }) {
+        mpz_fac_ui(z, n);
+        CHECK(to_string(factorial(n)) == mpz_to_string(z));
+        mpz_2fac_ui(z, n);
+        CHECK(to_string(double_factorial(n)) == mpz_to_string(z));
+        mpz_2fac_ui(z, n + 1);
+        CHECK(to_string(double_factorial(n + 1)) == mpz_to_string(z));
+        mpz_primorial_ui(z, n);
+        CHECK(to_string(primorial(n)) == mpz_to_string(z));
+
+        // both the product and the factorization paths of the binomial coefficient
+        for (unsigned long k : { 0ul, 1ul, 2ul, 7ul, 31ul, 32ul, 100ul, n / 3, n / 2, n - 1, n, n + 1 }) {
+            mpz_bin_uiui(z, n, k);
+            CHECK(to_string(binomial(n, k)) == mpz_to_string(z));
+        }
+    }
+
+    // the product path with factors close to the limb size
+    mpz_set_str(z, "18446744073709551557", 10);
+    mpz_bin_ui(z, z, 5);
+    CHECK(to_string(binomial(18446744073709551557ull, 5)) == mpz_to_string(z));
+    mpz_bin_uiui(z, 4000000000ul, 40);
+    CHECK(to_string(binomial(4000000000ull, 40)) == mpz_to_string(z));
+    mpz_clear(z);
+
+    integer r{ 7 };
+    factorial(r, 10);
+    CHECK_EQUAL(r, 3628800);
+    binomial(r, 52, 5);
+    CHECK_EQUAL(r, 2598960);
+    CHECK_EQUAL(binomial(2000, 1000), factorial(2000) / (factorial(1000) * factorial(1000)));
+    CHECK_EQUAL(double_factorial(2001) * double_factorial(2000), factorial(2001));
+}
+
+}
@@ -0,0 +1,190 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+#include "numetron/basic_integer_divisor.hpp"
+
+namespace numetron {
+
+void div_test()
+{
+    using namespace numetron::limb_arithmetic;
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+
+    std::mt19937_64 rng{ 0x0108 };
+    std::allocator<uint64_t> alloc;
+
+    // reciprocals below and above the Newton threshold, including the extreme divisors B^n / 2 and B^n - 1
+    for (size_t n : { (size_t)1, (size_t)2, (size_t)NUMETRON_INV_NEWTON_THRESHOLD - 1, (size_t)NUMETRON_INV_NEWTON_THRESHOLD,
+        (size_t)NUMETRON_INV_NEWTON_THRESHOLD + 1, (size_t)333, (size_t)1024 }) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            std::vector<uint64_t> d(n);
+            for (auto& l : d) l = pattern == 0 ? rng() : (pattern == 1 ? ~uint64_t{ 0 } : 0);
+            d.back() |= uint64_t{ 1 } << 63;
+
+            std::vector<uint64_t> x(n);
+            uinv(d.data(), n, x.data(), alloc);
+
+            std::vector<uint64_t> u(2 * n, ~uint64_t{ 0 }), q(n + 1), r(n);
+            mpn_tdiv_qr(reinterpret_cast<mp_limb_t*>(q.data()), reinterpret_cast<mp_limb_t*>(r.data()), 0,
+                reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)(2 * n), reinterpret_cast<mp_limb_t const*>(d.data()), (mp_size_t)n);
+            CHECK(q.back() == 1);
+            q.pop_back();
+            CHECK(x == q);
+        }
+    }
+
+    // the base case and the Newton division, balanced and unbalanced shapes; the high limbs of u equal
+    // to d give quotient limbs near B - 1 that the estimates are corrected for
+    const size_t thr = NUMETRON_DIV_NEWTON_THRESHOLD;
+    std::vector<std::pair<size_t, size_t>> shapes{ { 5, 2 }, { 100, 17 }, { 2 * thr - 2, thr - 1 }, { 2 * thr, thr },
+        { 2 * thr + 1, thr }, { 3 * thr, thr + 5 }, { 2000, 1000 }, { 5000, 700 }, { 1500, 1499 }, { 2500, 2000 } };
+    for (auto [un, dn] : shapes) {
+        for (int pattern = 0; pattern < 4; ++pattern) {
+            std::vector<uint64_t> u(un), d(dn);
+            for (auto& l : u) l = pattern == 1 ? ~uint64_t{ 0 } : rng();
+            for (auto& l : d) l = pattern == 1 ? ~uint64_t{ 0 } : rng();
+            if (pattern == 2) d.back() >>= 1 + rng() % 62;
+            if (pattern == 3) std::copy(d.begin(), d.end(), u.end() - dn);
+            d.back() |= 1;
+            u.back() |= 1;
+
+            std::vector<uint64_t> q(un), r(dn), qref(un), rref(dn);
+            udiv(std::span<const uint64_t>{ u }, std::span<const uint64_t>{ d }, std::span{ q }, std::span{ r });
+            mpn_tdiv_qr(reinterpret_cast<mp_limb_t*>(qref.data()), reinterpret_cast<mp_limb_t*>(rref.data()), 0,
+                reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un, reinterpret_cast<mp_limb_t const*>(d.data()), (mp_size_t)dn);
+            CHECK(q == qref);
+            CHECK(r == rref);
+        }
+    }
+
+    // the operators go through the same division
+    {
+        std::string us(20000, '0'), ds(9000, '0');
+        for (auto& c : us) c = static_cast<char>('0' + rng() % 10);
+        for (auto& c : ds) c = static_cast<char>('0' + rng() % 10);
+        us.front() = ds.front() = '7';
+
+        mpz_t zu, zd, zq, zr;
+        mpz_inits(zu, zd, zq, zr, nullptr);
+        mpz_set_str(zu, us.c_str(), 10);
+        mpz_set_str(zd, ds.c_str(), 10);
+        mpz_tdiv_qr(zq, zr, zu, zd);
+        std::string qs(mpz_sizeinbase(zq, 10) + 2, '\0'), rs(mpz_sizeinbase(zr, 10) + 2, '\0');
+        mpz_get_str(qs.data(), 10, zq);
+        mpz_get_str(rs.data(), 10, zr);
+        qs.resize(std::strlen(qs.c_str()));
+        rs.resize(std::strlen(rs.c_str()));
+        mpz_clears(zu, zd, zq, zr, nullptr);
+
+        integer iu{ std::string_view{ us } }, id{ std::string_view{ ds } };
+        CHECK(to_string(iu / id) == qs);
+        CHECK(to_string(iu % id) == rs);
+
+        integer_divisor pd{ id };
+        CHECK(to_string(iu / pd) == qs);
+        CHECK(to_string(iu % pd) == rs);
+    }
+
+    // a prepared divisor against the operators for one-limb, small and Newton-sized divisors and both signs,
+    // the dividends are shorter than, as long as and longer than the divisor
+    for (size_t dn : { (size_t)1, (size_t)2, (size_t)7, thr + 3 }) {
+        for (int dsign : { 1, -1 }) {
+            std::vector<uint64_t> d(dn);
+            for (auto& l : d) l = rng();
+            d.back() >>= rng() % 63;
+            d.back() |= 1;
+            integer id{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ d }, dsign } };
+            integer_divisor pd{ id };
+            CHECK(pd.sgn() == dsign);
+            CHECK(pd.size() == dn);
+
+            for (size_t un : { dn - 1, dn, dn + 1, 3 * dn + 10 }) {
+                for (int usign : { 1, -1 }) {
+                    std::vector<uint64_t> u(un);
+                    for (auto& l : u) l = rng();
+                    integer iu{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ u }, usign } };
+
+                    integer q = pd.div(iu), r = pd.mod(iu);
+                    CHECK(q * id + r == iu);
+                    CHECK(r.sgn() == 0 || r.sgn() == usign);
+                    integer ra = r.sgn() < 0 ? -r : r, da = dsign < 0 ? -id : id;
+                    CHECK(ra < da);
+
+                    auto [q2, r2] = pd.divmod(iu);
+                    CHECK(q2 == q);
+                    CHECK(r2 == r);
+
+                    // the truncated quotient agrees with the operator
+                    integer qdiv = iu;
+                    integer rdiv = qdiv.div_qr(id);
+                    CHECK(q == rdiv);
+                    CHECK(r == qdiv);
+                }
+            }
+        }
+    }
+
+    // exact division: the limb by limb and the blocked Hensel paths, odd and even divisors, divisors with zero low
+    // limbs, quotients shorter and longer than the divisor
+    const size_t bthr = NUMETRON_BDIV_Q_THRESHOLD;
+    std::vector<std::pair<size_t, size_t>> exact_shapes{ { 1, 1 }, { 7, 1 }, { 1, 9 }, { 30, 5 }, { bthr - 1, bthr - 1 },
+        { bthr, bthr }, { 3 * bthr + 1, bthr }, { bthr + 1, 3 * bthr }, { 500, 300 }, { 2000, 2000 }, { 5000, 700 } };
+    for (auto [qn, dn] : exact_shapes) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            std::vector<uint64_t> q(qn), d(dn), u(qn + dn);
+            for (auto& l : q) l = rng();
+            for (auto& l : d) l = rng();
+            if (pattern == 1) d.front() <<= 1 + rng() % 63;
+            if (pattern == 2) d.front() = 0;
+            q.back() |= 1;
+            d.back() |= 1;
+            umul_dispatch(q.data(), qn, d.data(), dn, u.data(), alloc);
+
+            std::vector<uint64_t> qx(qn + dn);
+            size_t qxn = udivexact(u.data(), u.size(), d.data(), dn, qx.data(), alloc);
+            qx.resize(qxn);
+            CHECK(qx == q);
+
+            integer iu{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ u }, pattern == 1 ? -1 : 1 } };
+            integer id{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ d }, 1 } };
+            CHECK_EQUAL(divexact(iu, id), iu / id);
+            CHECK_EQUAL(divexact(iu, -id), iu / -id);
+        }
+    }
+
+    // the 2-adic inverse: d x = 1 (mod B^k)
+    for (size_t k : { (size_t)1, (size_t)2, (size_t)3, (size_t)17, (size_t)100 }) {
+        std::vector<uint64_t> d(k + 2), x(k), p(2 * k + 2);
+        for (auto& l : d) l = rng();
+        d.front() |= 1;
+        ubinvert(d.data(), d.size(), k, x.data(), alloc);
+        umul_dispatch(d.data(), d.size(), x.data(), k, p.data(), alloc);
+        CHECK(p.front() == 1);
+        CHECK(std::all_of(p.begin() + 1, p.begin() + k, [](uint64_t l) { return !l; }));
+    }
+
+    CHECK_EQUAL(divexact(integer{ 0 }, 7), 0);
+    CHECK_EQUAL(divexact(integer{ -91 }, 7), -13);
+    CHECK_EQUAL(divexact(integer{ 1 } << 200u, integer{ 1 } << 130u), integer{ 1 } << 70u);
+    int thrown = 0;
+    try { (void)divexact(integer{ 5 }, 0); } catch (std::runtime_error const&) { ++thrown; }
+    CHECK_EQUAL(thrown, 1);
+}
+
+}
@@ -0,0 +1,78 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+#include "numetron/basic_decimal.hpp"
+
+namespace numetron {
+
+void from_string_test()
+{
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+
+    std::mt19937_64 rng{ 0x0106 };
+    std::allocator<uint64_t> alloc;
+    mpz_t z;
+    mpz_init(z);
+
+    auto equal_to_ref = [&z](uint64_t const* p, size_t n) {
+        return mpz_size(z) == n && !std::memcmp(p, mpz_limbs_read(z), n * sizeof(uint64_t));
+    };
+
+    // digit counts around the divide and conquer threshold and well above it, the parsing stops at the first
+    // character that is not a digit
+    const size_t thr_digits = NUMETRON_SET_STR_DC_THRESHOLD * 19;
+    for (size_t nd : { (size_t)1, (size_t)20, thr_digits - 1, thr_digits + 20, (size_t)5000, (size_t)30000 }) {
+        for (unsigned int base : { 10, 3, 7, 36 }) {
+            for (int pattern = 0; pattern < 3; ++pattern) {
+                std::string s;
+                for (size_t i = 0; i < nd; ++i) {
+                    unsigned int d = pattern == 0 ? rng() % base : (pattern == 1 ? base - 1 : (rng() % 7 ? 0 : rng() % base));
+                    s.push_back(detail::default_alphabet[d]);
+                }
+                s.front() = '1';
+                mpz_set_str(z, s.c_str(), (int)base);
+
+                std::string input = s + "!1";
+                std::string_view str = input;
+                auto res = to_limbs<uint64_t>(str, base, alloc);
+                CHECK(res.has_value());
+                auto [p, n, cap, sign] = *res;
+                CHECK(equal_to_ref(p, n));
+                CHECK(str == "!1");
+                alloc.deallocate(p, cap);
+
+                if (base != 10) continue;
+
+                // the significand of a decimal with a point in the middle
+                s.back() = '1';
+                std::string ds = s.substr(0, nd / 2) + "." + s.substr(nd / 2);
+                std::string_view dstr = ds;
+                int64_t exp;
+                auto dres = to_significand_limbs<uint64_t>(dstr, alloc, exp);
+                CHECK(dres.has_value());
+                auto [dp, dn, dcap, dsign] = *dres;
+                mpz_set_str(z, s.c_str(), 10);
+                CHECK(equal_to_ref(dp, dn));
+                CHECK(exp == -static_cast<int64_t>(nd - nd / 2));
+                alloc.deallocate(dp, dcap);
+            }
+        }
+    }
+    mpz_clear(z);
+}
+
+}
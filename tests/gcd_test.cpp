@@ -0,0 +1,135 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+namespace {
+
+std::string mpz_to_string(mpz_t const z)
+{
+    std::string s(mpz_sizeinbase(z, 10) + 2, '\0');
+    mpz_get_str(s.data(), 10, z);
+    s.resize(std::strlen(s.c_str()));
+    return s;
+}
+
+std::string mpz_gcd_string(integer const& a, integer const& b)
+{
+    mpz_t za, zb;
+    mpz_inits(za, zb, nullptr);
+    mpz_set_str(za, to_string(a).c_str(), 10);
+    mpz_set_str(zb, to_string(b).c_str(), 10);
+    mpz_gcd(za, za, zb);
+    std::string s = mpz_to_string(za);
+    mpz_clears(za, zb, nullptr);
+    return s;
+}
+
+}
+
+void gcd_test()
+{
+    std::mt19937_64 rng{ 0x0114 };
+    auto random = [&rng](size_t n) {
+        if (!n) return integer{ 0 };
+        std::vector<uint64_t> l(n);
+        for (auto& x : l) x = rng();
+        return integer{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ l }, (rng() & 1) ? 1 : -1 } };
+    };
+
+    // the sizes cover the single limb gcd, Lehmer's steps, the half-gcd with and without recursion; the common
+    // factors make the results nontrivial and unbalanced operands start with a division step
+    for (size_t n : { 1, 2, 5, 40, 100, 170, 300, 700 }) {
+        for (int rep = 0; rep < 3; ++rep) {
+            integer a = random(n), b = random(n + rep - 1);
+            CHECK(to_string(gcd(a, b)) == mpz_gcd_string(a, b));
+            integer g = random(1 + rep * n / 3);
+            integer x = a * g, y = b * g;
+            CHECK(to_string(gcd(x, y)) == mpz_gcd_string(x, y));
+            CHECK(to_string(gcd(y, x)) == mpz_gcd_string(x, y));
+            integer z = random(n / 4 + 1) * g;
+            CHECK(to_string(gcd(x, z)) == mpz_gcd_string(x, z));
+            integer ax = x < 0 ? -x : x;
+            CHECK_EQUAL(gcd(x, x), ax);
+            CHECK_EQUAL(gcd(x, 0), ax);
+            CHECK_EQUAL(gcd(integer{ 0 }, -x), ax);
+        }
+    }
+
+    // consecutive Fibonacci numbers are coprime and have all quotients equal to 1
+    integer f0 = 0, f1 = 1;
+    for (int i = 0; i < 5000; ++i) {
+        f0 += f1;
+        std::swap(f0, f1);
+    }
+    CHECK_EQUAL(gcd(f0, f1), 1);
+    CHECK_EQUAL(gcd(f0 * 12345, f1 * 6789), 3);
+
+    // the cofactors are the ones of the Euclidean sequence, the same as GMP's; the in-place variants may
+    // overwrite their operands
+    mpz_t za, zb, zg, zs, zt;
+    mpz_inits(za, zb, zg, zs, zt, nullptr);
+    for (size_t n : { 0, 1, 2, 5, 40, 170, 700 }) {
+        for (int rep = 0; rep < 3; ++rep) {
+            integer g0 = random(1 + rep * n / 4);
+            integer a = random(n) * g0, b = random(n + rep > 1 ? n + rep - 1 : 0) * g0;
+            mpz_set_str(za, to_string(a).c_str(), 10);
+            mpz_set_str(zb, to_string(b).c_str(), 10);
+            mpz_gcdext(zg, zs, zt, za, zb);
+            auto [g, s, t] = gcdext(a, b);
+            CHECK(to_string(g) == mpz_to_string(zg));
+            CHECK(to_string(s) == mpz_to_string(zs));
+            CHECK(to_string(t) == mpz_to_string(zt));
+
+            integer x = a, y = b, z;
+            gcdext(x, y, z, x, y);
+            CHECK_EQUAL(x, g);
+            CHECK_EQUAL(y, s);
+            CHECK_EQUAL(z, t);
+
+            integer r = 5;
+            bool invertible = mpz_invert(zs, za, zb) != 0;
+            CHECK_EQUAL(invert(r, a, b), invertible);
+            if (invertible) {
+                CHECK(to_string(r) == mpz_to_string(zs));
+                CHECK_EQUAL(invert(a, b), r);
+            } else {
+                CHECK_EQUAL(r, 5);
+            }
+        }
+    }
+    mpz_clears(za, zb, zg, zs, zt, nullptr);
+
+    integer r;
+    CHECK(invert(r, integer{ 3 }, integer{ 7 }) && r == 5);
+    CHECK(invert(r, integer{ -3 }, integer{ 7 }) && r == 2);
+    CHECK(invert(r, integer{ 12 }, integer{ 1 }) && r == 0);
+    CHECK(!invert(r, integer{ 6 }, integer{ 9 }));
+    CHECK(!invert(r, integer{ 6 }, integer{ 0 }));
+    bool thrown = false;
+    try { (void)invert(integer{ 4 }, 10); } catch (std::domain_error const&) { thrown = true; }
+    CHECK(thrown);
+
+    CHECK_EQUAL(gcd(integer{ 0 }, integer{ 0 }), 0);
+    CHECK_EQUAL(gcd(integer{ -12 }, integer{ 18 }), 6);
+    CHECK_EQUAL(gcd(integer{ 1 } << 200u, integer{ 1 } << 130u), integer{ 1 } << 130u);
+}
+
+}
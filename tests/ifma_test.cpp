@@ -0,0 +1,67 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+void ifma_test()
+{
+#if defined(NUMETRON_USE_ASM) && (defined(__x86_64__) || defined(_M_X64)) && defined(NUMETRON_PLATFORM_AUTODETECT)
+    using namespace numetron::limb_arithmetic;
+
+    if (!(numetron_detect_platform() & platform_feature_avx512ifma)) {
+        CHECK(!kernel_table.mul_basecase_ifma && !kernel_table.sqr_basecase_ifma);
+        std::cout << "AVX-512 IFMA is not available, the radix 2^52 kernels are skipped\n";
+        return;
+    }
+    CHECK(kernel_table.mul_basecase_ifma && kernel_table.sqr_basecase_ifma);
+
+    std::mt19937_64 rng{ 0x1F3A };
+    for (size_t un = 1; un <= NUMETRON_IFMA_MUL_MAX_LIMBS; ++un) {
+        for (int pattern = 0; pattern < 2; ++pattern) {
+            std::vector<uint64_t> u(un);
+            for (auto& l : u) l = pattern ? ~uint64_t{ 0 } : rng();
+
+            // the conversion to the 2^52 radix and back
+            std::vector<uint64_t> d(limb_arithmetic::detail::radix52_capacity(un), ~uint64_t{ 0 }), back(un);
+            limb_arithmetic::detail::to_radix52(u.data(), un, d.data());
+            for (size_t i = 0; i < d.size(); ++i) {
+                CHECK(i < limb_arithmetic::detail::radix52_size(un) ? d[i] <= limb_arithmetic::detail::radix52_mask : !d[i]);
+            }
+            limb_arithmetic::detail::from_radix52(d.data(), back.data(), un);
+            CHECK(back == u);
+
+            std::vector<uint64_t> r(2 * un), ref(2 * un);
+            usqr_basecase_ifma(r.data(), u.data(), un);
+            mpn_sqr(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un);
+            CHECK(r == ref);
+
+            for (size_t vn : { size_t{ 1 }, size_t{ 2 }, un / 3, un / 2, un - 1, un }) {
+                if (!vn || vn > un) continue;
+                std::vector<uint64_t> v(vn);
+                for (auto& l : v) l = pattern ? ~uint64_t{ 0 } : rng();
+                std::vector<uint64_t> rm(un + vn), refm(un + vn);
+                umul_basecase_ifma(rm.data(), u.data(), un, v.data(), vn);
+                mpn_mul(reinterpret_cast<mp_limb_t*>(refm.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un,
+                    reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)vn);
+                CHECK(rm == refm);
+            }
+        }
+    }
+#endif
+}
+
+}
@@ -0,0 +1,72 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#include "numetron/basic_integer.hpp"
+#include "numetron/integer_expression.hpp"
+
+namespace numetron {
+
+void integer_expression_test()
+{
+    using namespace numetron::literals;
+
+    std::mt19937_64 rng{ 0x0113 };
+    auto random = [&rng](size_t n) {
+        if (!n) return integer{ 0 };
+        std::vector<uint64_t> l(n);
+        for (auto& x : l) x = rng();
+        return integer{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ l }, (rng() & 1) ? 1 : -1 } };
+    };
+
+    // the lazy results agree with the eager operators; the sizes cover zero and inplaced operands, the basecase
+    // and the Toom multiplication, the shifts are by whole limbs, by bits and past the value
+    for (size_t n : { 0, 1, 2, 5, 40, 100 }) {
+        for (int rep = 0; rep < 4; ++rep) {
+            integer a = random(n), b = random(n / 2 + rep), c = random(n + rep), d = random(1 + rep), e = random(2 * n + 1);
+            for (unsigned int k : { 0u, 1u, 5u, 63u, 64u, 130u, 64u * 300u }) {
+                integer r = (lazy(a) * b + lazy(c) * d - e) >> k;
+                CHECK_EQUAL(r, (a * b + c * d - e) >> k);
+                r = (lazy(a) - b) << k;
+                CHECK_EQUAL(r, (a - b) << k);
+                r = ((lazy(e) << k) - c) >> k;
+                CHECK_EQUAL(r, ((e << k) - c) >> k);
+            }
+            integer r = -(lazy(a) * b) + c;
+            CHECK_EQUAL(r, c - a * b);
+            r = (lazy(a) + b) * (lazy(c) - d);
+            CHECK_EQUAL(r, (a + b) * (c - d));
+            r = lazy(a) * a - e * e;
+            CHECK_EQUAL(r, a * a - e * e);
+            r = 5 - lazy(a) * 3u + 7;
+            CHECK_EQUAL(r, 5 - a * 3u + 7);
+            r = lazy(a) - a;
+            CHECK_EQUAL(r, 0);
+            CHECK(!r);
+
+            basic_integer<uint64_t, 4> r4 = lazy(a) * b - c;
+            CHECK(r4 == a * b - c);
+            CHECK_EQUAL((lazy(c) * d).eval(), c * d);
+        }
+    }
+
+    integer a = "0x1fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"_bi, b = -3;
+    integer r = (lazy(a) + 1) >> 256u;
+    CHECK_EQUAL(r, 0);
+    r = (lazy(a) + 1) >> 253u;
+    CHECK_EQUAL(r, 1);
+    r = lazy(b) * b * b;
+    CHECK_EQUAL(r, -27);
+    r = (lazy(b) << 1u) - b;
+    CHECK_EQUAL(r, -3);
+    r = lazy(a) * b;
+    r = lazy(r) + r;
+    CHECK_EQUAL(r, a * -6);
+}
+
+}
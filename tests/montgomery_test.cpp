@@ -0,0 +1,127 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+#include "numetron/montgomery.hpp"
+
+namespace numetron {
+
+namespace {
+
+std::string mpz_to_string(mpz_t const z)
+{
+    std::string s(mpz_sizeinbase(z, 10) + 2, '\0');
+    mpz_get_str(s.data(), 10, z);
+    s.resize(std::strlen(s.c_str()));
+    return s;
+}
+
+void mpz_set_limbs(mpz_t z, std::vector<uint64_t> const& limbs, int sign)
+{
+    mpz_import(z, limbs.size(), -1, sizeof(uint64_t), 0, 0, limbs.data());
+    if (sign < 0) mpz_neg(z, z);
+}
+
+}
+
+void montgomery_test()
+{
+    std::mt19937_64 rng{ 0x0110 };
+    auto random_limbs = [&rng](size_t n) {
+        std::vector<uint64_t> v(n);
+        for (auto& l : v) l = rng();
+        return v;
+    };
+    auto make = [](std::vector<uint64_t> const& limbs, int sign) {
+        if (limbs.empty()) return integer{ 0 };
+        return integer{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ limbs }, sign } };
+    };
+
+    mpz_t zb, ze, zm, zr;
+    mpz_inits(zb, ze, zm, zr, nullptr);
+
+    // one-limb, small, the inplace limit and beyond it, and a modulus large enough for the Toom multiplication;
+    // the bases are shorter and longer than the modulus and of both signs
+    for (size_t n : { (size_t)1, (size_t)2, (size_t)5, (size_t)NUMETRON_MONTGOMERY_INPLACE_LIMBS, (size_t)NUMETRON_MONTGOMERY_INPLACE_LIMBS + 1, (size_t)100 }) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            std::vector<uint64_t> m = pattern == 1 ? std::vector<uint64_t>(n, ~uint64_t{ 0 }) : random_limbs(n);
+            if (pattern == 2) m.back() >>= 1 + rng() % 62;
+            m.front() |= 1;
+            m.back() |= 1;
+            integer im = make(m, 1);
+            montgomery_context<uint64_t> ctx{ im };
+            CHECK(ctx.size() == n);
+            mpz_set_limbs(zm, m, 1);
+
+            for (size_t bn : { n - 1, n, 2 * n + 1 }) {
+                for (int bsign : { 1, -1 }) {
+                    std::vector<uint64_t> b = random_limbs(bn);
+                    integer ib = make(b, bsign);
+                    mpz_set_limbs(zb, b, bsign);
+
+                    for (size_t en : { (size_t)0, (size_t)1, (size_t)2, n }) {
+                        std::vector<uint64_t> e = random_limbs(en);
+                        if (en == 1) e.front() >>= rng() % 64;
+                        integer ie = make(e, 1);
+                        mpz_set_limbs(ze, e, 1);
+
+                        mpz_powm(zr, zb, ze, zm);
+                        CHECK(to_string(ctx.powm(ib, ie)) == mpz_to_string(zr));
+                    }
+
+                    std::vector<uint64_t> c = random_limbs(n);
+                    mpz_set_limbs(zr, c, 1);
+                    mpz_mul(zr, zb, zr);
+                    mpz_mod(zr, zr, zm);
+                    CHECK(to_string(ctx.mulm(ib, make(c, 1))) == mpz_to_string(zr));
+                }
+            }
+        }
+    }
+
+    // edge exponents and bases
+    {
+        integer m{ "1000000000000000000000000000000000000000000000000000000000000000000000007" };
+        CHECK(powm(integer{ 12345 }, integer{ 0 }, m) == 1);
+        CHECK(powm(integer{ 0 }, integer{ 0 }, m) == 1);
+        CHECK(powm(integer{ 0 }, integer{ 5 }, m) == 0);
+        CHECK(powm(integer{ -1 }, integer{ 3 }, m) == m - 1);
+        CHECK(powm(m, integer{ 3 }, m) == 0);
+        CHECK(powm(integer{ 7 }, integer{ 1 }, m) == 7);
+        CHECK(powm(integer{ 7 }, integer{ 100 }, integer{ 1 }) == 0);
+        CHECK(powm(integer{ 7 }, integer{ 0 }, integer{ 1 }) == 0);
+        CHECK(powm(integer{ 3 }, integer{ 5 }, integer{ -7 }) == 5);
+
+        // Fermat's little theorem for a prime modulus
+        integer p{ "170141183460469231731687303715884105727" }; // 2^127 - 1
+        CHECK(powm(integer{ 3 }, p - 1, p) == 1);
+        CHECK(powm(integer{ 123456789 }, p, p) == 123456789);
+
+        bool thrown = false;
+        try { (void)montgomery_context<uint64_t>{ integer{ 10 } }; } catch (std::invalid_argument const&) { thrown = true; }
+        CHECK(thrown);
+        thrown = false;
+        try { (void)montgomery_context<uint64_t>{ integer{ 0 } }; } catch (std::invalid_argument const&) { thrown = true; }
+        CHECK(thrown);
+        thrown = false;
+        try { (void)powm(integer{ 3 }, integer{ -1 }, m); } catch (std::invalid_argument const&) { thrown = true; }
+        CHECK(thrown);
+    }
+
+    mpz_clears(zb, ze, zm, zr, nullptr);
+}
+
+}
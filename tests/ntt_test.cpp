@@ -0,0 +1,75 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+void ntt_test()
+{
+    using namespace numetron::limb_arithmetic;
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+
+    std::mt19937_64 rng{ 0x0117 };
+    std::allocator<uint64_t> alloc;
+
+    auto fill = [&rng](std::vector<uint64_t>& u, int pattern) {
+        for (auto& l : u) {
+            l = pattern == 0 ? rng() : (pattern == 1 ? ~uint64_t{ 0 } : (rng() & 1) * ~uint64_t{ 0 });
+        }
+        u.back() |= 1;
+    };
+
+    // the transform itself is size agnostic: small, power of two and odd shapes,
+    // all-ones operands give the largest coefficients the CRT has to recover
+    std::vector<std::pair<size_t, size_t>> shapes{ { 1, 1 }, { 2, 1 }, { 5, 3 }, { 64, 64 }, { 65, 64 }, { 100, 37 }, { 1000, 999 }, { 4000, 3 } };
+    for (auto [un, vn] : shapes) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            std::vector<uint64_t> u(un), v(vn);
+            fill(u, pattern);
+            fill(v, pattern);
+
+            std::vector<uint64_t> r(un + vn), ref(un + vn);
+            umul_ntt(u.data(), un, v.data(), vn, r.data(), alloc);
+            mpn_mul(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un,
+                reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)vn);
+            CHECK(r == ref);
+
+            std::vector<uint64_t> s(2 * un), sref(2 * un);
+            usqr_ntt(u.data(), un, s.data(), alloc);
+            mpn_sqr(reinterpret_cast<mp_limb_t*>(sref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un);
+            CHECK(s == sref);
+        }
+    }
+
+    // dispatch above the thresholds
+    {
+        const size_t n = (std::max)((size_t)NUMETRON_MUL_NTT_THRESHOLD, (size_t)NUMETRON_SQR_NTT_THRESHOLD) + 1;
+        std::vector<uint64_t> u(n + 7), v(n);
+        fill(u, 0);
+        fill(v, 0);
+        std::vector<uint64_t> r(2 * n + 7), ref(2 * n + 7);
+        umul_dispatch(u.data(), u.size(), v.data(), v.size(), r.data(), alloc);
+        mpn_mul(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)u.size(),
+            reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)v.size());
+        CHECK(r == ref);
+
+        std::vector<uint64_t> s(2 * n), sref(2 * n);
+        usqr_dispatch(v.data(), n, s.data(), alloc);
+        mpn_sqr(reinterpret_cast<mp_limb_t*>(sref.data()), reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)n);
+        CHECK(s == sref);
+    }
+}
+
+}
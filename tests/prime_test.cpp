@@ -0,0 +1,87 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#include <string>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+#include "numetron/prime.hpp"
+
+namespace numetron {
+
+namespace {
+
+std::string mpz_to_string(mpz_t const z)
+{
+    std::string s(mpz_sizeinbase(z, 10) + 2, '\0');
+    mpz_get_str(s.data(), 10, z);
+    s.resize(std::strlen(s.c_str()));
+    return s;
+}
+
+}
+
+void prime_test()
+{
+    std::mt19937_64 rng{ 0x0117 };
+    auto random = [&rng](size_t n) {
+        std::vector<uint64_t> l(n);
+        for (auto& x : l) x = rng();
+        l.back() >>= rng() % 64;
+        l.front() |= 1;
+        return integer{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ l }, 1 } };
+    };
+
+    mpz_t z;
+    mpz_init(z);
+
+    // the small values are decided by the trial division, the larger ones by the Baillie-PSW test
+    for (int v = -10; v < 5000; ++v) {
+        mpz_set_si(z, v);
+        CHECK_EQUAL(is_probable_prime(integer{ v }), mpz_probab_prime_p(z, 25) != 0);
+    }
+    for (size_t n : { 1, 2, 3, 5, 9 }) {
+        for (int rep = 0; rep < 200; ++rep) {
+            integer a = random(n);
+            mpz_set_str(z, to_string(a).c_str(), 10);
+            CHECK_EQUAL(is_probable_prime(a), mpz_probab_prime_p(z, 25) != 0);
+            if (rep % 20) continue;
+            mpz_nextprime(z, z);
+            integer p = next_prime(a);
+            CHECK(to_string(p) == mpz_to_string(z));
+            CHECK(is_probable_prime(p, 30));
+            CHECK(!is_probable_prime(p * next_prime(p)));
+        }
+    }
+    mpz_clear(z);
+
+    // strong pseudoprimes to the small bases, a Carmichael number, Mersenne numbers, a composite Fermat number
+    CHECK(!is_probable_prime(integer{ 3825123056546413051ull }));
+    CHECK(!is_probable_prime(integer{ 2152302898747ull }));
+    CHECK(!is_probable_prime(integer{ 3474749660383ull }));
+    CHECK(!is_probable_prime(integer{ 41041 }));
+    CHECK(is_probable_prime((integer{ 1 } << 127u) - 1));
+    CHECK(is_probable_prime((integer{ 1 } << 521u) - 1));
+    CHECK(!is_probable_prime((integer{ 1 } << 523u) - 1));
+    CHECK(!is_probable_prime((integer{ 1 } << 128u) + 1));
+    CHECK(is_probable_prime(integer{ 18446744073709551557ull }));
+    CHECK(is_probable_prime(integer{ -7 }));
+
+    CHECK_EQUAL(next_prime(integer{ -5 }), 2);
+    CHECK_EQUAL(next_prime(integer{ 2 }), 3);
+    CHECK_EQUAL(next_prime(integer{ 1048573 }), 1048583);
+    CHECK_EQUAL(next_prime(integer{ 18446744073709551557ull }), (integer{ 1 } << 64u) + 13);
+}
+
+}
@@ -0,0 +1,126 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+namespace {
+
+std::string mpz_to_string(mpz_t const z)
+{
+    std::string s(mpz_sizeinbase(z, 10) + 2, '\0');
+    mpz_get_str(s.data(), 10, z);
+    s.resize(std::strlen(s.c_str()));
+    return s;
+}
+
+}
+
+void root_test()
+{
+    std::mt19937_64 rng{ 0x0116 };
+    auto random = [&rng](size_t n) {
+        if (!n) return integer{ 0 };
+        std::vector<uint64_t> l(n);
+        for (auto& x : l) x = rng();
+        l.back() >>= rng() % 64;
+        return integer{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ l }, 1 } };
+    };
+
+    mpz_t za, zs, zr;
+    mpz_inits(za, zs, zr, nullptr);
+
+    // the sizes cover the single and the double limb roots, odd and even sizes and several levels of the
+    // Karatsuba square root; the shifts of the leading limb exercise the normalization
+    for (size_t n : { 1, 2, 3, 4, 5, 8, 13, 40, 101, 300 }) {
+        for (int rep = 0; rep < 4; ++rep) {
+            integer a = random(n);
+            mpz_set_str(za, to_string(a).c_str(), 10);
+            mpz_sqrtrem(zs, zr, za);
+            auto [s, r] = sqrtrem(a);
+            CHECK(to_string(s) == mpz_to_string(zs));
+            CHECK(to_string(r) == mpz_to_string(zr));
+            CHECK_EQUAL(isqrt(a), s);
+
+            integer x = a, y;
+            sqrtrem(x, y, x);
+            CHECK_EQUAL(x, s);
+            CHECK_EQUAL(y, r);
+
+            CHECK(is_perfect_square(s * s));
+            CHECK_EQUAL(isqrt(s * s), s);
+            CHECK_EQUAL(isqrt(s * s + 2 * s), s);
+            CHECK(!is_perfect_square(s * s + 1) || s == 0);
+            CHECK_EQUAL(is_perfect_square(a), mpz_perfect_square_p(za) != 0);
+
+            for (unsigned int k : { 3u, 4u, 5u, 7u, 31u, 64u, 129u }) {
+                mpz_root(zs, za, k);
+                CHECK(to_string(iroot(a, k)) == mpz_to_string(zs));
+                mpz_neg(zr, za);
+                mpz_root(zs, zr, k | 1);
+                CHECK(to_string(iroot(-a, k | 1)) == mpz_to_string(zs));
+            }
+
+            integer b = random(n / 4 + 1) + 2;
+            for (unsigned int k : { 2u, 3u, 6u, 7u }) {
+                integer p = pow(b, k);
+                CHECK(is_perfect_power(p));
+                CHECK_EQUAL(iroot(p, k), b);
+                CHECK_EQUAL(iroot(p - 1, k), b - 1);
+                mpz_set_str(za, to_string(p + 1).c_str(), 10);
+                CHECK_EQUAL(is_perfect_power(p + 1), mpz_perfect_power_p(za) != 0);
+            }
+            CHECK(is_perfect_power(-pow(b, 3u)));
+        }
+    }
+    mpz_clears(za, zs, zr, nullptr);
+
+    // the all-ones limbs have the largest possible roots
+    for (size_t n : { 1, 2, 3, 10 }) {
+        integer a = (integer{ 1 } << (64u * n)) - 1;
+        auto [s, r] = sqrtrem(a);
+        CHECK_EQUAL(s, (integer{ 1 } << (32u * n)) - 1);
+        CHECK_EQUAL(r, (s << 1u));
+    }
+
+    for (int v = 0; v < 300; ++v) {
+        integer a = v;
+        CHECK_EQUAL(is_perfect_square(a), isqrt(a) * isqrt(a) == a);
+        CHECK_EQUAL(iroot(a, 3u) * iroot(a, 3u) * iroot(a, 3u) <= a, true);
+    }
+    CHECK(is_perfect_power(integer{ 0 }));
+    CHECK(is_perfect_power(integer{ 1 }));
+    CHECK(is_perfect_power(integer{ -1 }));
+    CHECK(is_perfect_power(integer{ 1 } << 67u));
+    CHECK(!is_perfect_power(integer{ -4 }));
+    CHECK(is_perfect_power(integer{ -8 }));
+    CHECK(!is_perfect_power(integer{ 3 } << 64u));
+    CHECK(!is_perfect_power(integer{ 72 }));
+    CHECK(!is_perfect_square(integer{ -4 }));
+    CHECK_EQUAL(iroot(integer{ -27 }, 3u), -3);
+    CHECK_EQUAL(iroot(integer{ 5 }, 1u), 5);
+
+    int thrown = 0;
+    try { (void)isqrt(integer{ -1 }); } catch (std::domain_error const&) { ++thrown; }
+    try { (void)iroot(integer{ -16 }, 4u); } catch (std::domain_error const&) { ++thrown; }
+    try { (void)iroot(integer{ 16 }, 0u); } catch (std::domain_error const&) { ++thrown; }
+    CHECK_EQUAL(thrown, 3);
+}
+
+}
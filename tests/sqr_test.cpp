@@ -0,0 +1,72 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+void sqr_test()
+{
+    using namespace numetron::limb_arithmetic;
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+
+    std::mt19937_64 rng{ 0x5157 };
+    std::allocator<uint64_t> alloc;
+
+    // sizes around every squaring threshold: split basecase, Karatsuba, Toom-3
+    std::vector<size_t> sizes;
+    for (size_t n = 1; n <= 40; ++n) sizes.push_back(n);
+    for (size_t thr : { (size_t)NUMETRON_SQR_KARATSUBA_THRESHOLD, (size_t)NUMETRON_SQR_TOOM3_THRESHOLD }) {
+        for (size_t n = thr - 3; n <= thr + 3; ++n) sizes.push_back(n);
+    }
+    for (size_t n : { 100, 250, 333, 500, 1024, 1500 }) sizes.push_back(n);
+
+    for (size_t n : sizes) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            std::vector<uint64_t> u(n);
+            for (auto& l : u) {
+                l = pattern == 0 ? rng() : (pattern == 1 ? ~uint64_t{ 0 } : (rng() & 0xff));
+            }
+            u.back() |= 1; // keep the top limb significant
+
+            std::vector<uint64_t> r(2 * n), ref(2 * n), rmul(2 * n);
+            usqr_dispatch(u.data(), n, r.data(), alloc);
+            mpn_sqr(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)n);
+            CHECK(r == ref);
+
+            // the generic triangular kernel, regardless of dispatch
+            usqr_basecase(u.data(), n, rmul.data());
+            CHECK(rmul == ref);
+
+            // u * u is routed to the squaring path
+            std::fill(rmul.begin(), rmul.end(), 0);
+            umul_dispatch(u.data(), n, u.data(), n, rmul.data(), alloc);
+            CHECK(rmul == ref);
+        }
+    }
+
+    // basic_integer level: x * x and pow
+    using integer_t = basic_integer<uint64_t, 1>;
+    for (size_t n : { 2, 17, 90, 200 }) {
+        std::vector<uint64_t> u(n);
+        for (auto& l : u) l = rng();
+        integer_t x{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ u } } };
+        integer_t y = x;
+        CHECK_EQUAL(x * x, x * y);
+        CHECK_EQUAL(pow(x, 5u), x * y * x * y * x);
+        CHECK_EQUAL(pow(-x, 2u), x * y);
+    }
+}
+
+}
@@ -32,6 +32,20 @@ void ct_test();
 
 void mul_test();
 void mpn_mul_test();
+void sqr_test();
+void toom_test();
+void ntt_test();
+void to_string_test();
+void from_string_test();
+void div_test();
+void montgomery_test();
+void integer_expression_test();
+void gcd_test();
+void root_test();
+void prime_test();
+void combinatorics_test();
+void ifma_test();
+void batch_mul_test();
 
 void test_float16_basic_operations();
 void test_float16_special_values();
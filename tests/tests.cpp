@@ -61,6 +61,20 @@ TEST(NumetronTest, float16_floating_point_three_way_comparison_derived_operators
 TEST(NumetronTest, basic_integer) { basic_integer_test0(); }
 TEST(NumetronTest, basic_decimal) { basic_decimal_test0(); }
 TEST(NumetronTest, compile_time) { ct_test(); }
+TEST(NumetronTest, sqr) { sqr_test(); }
+TEST(NumetronTest, toom) { toom_test(); }
+TEST(NumetronTest, ntt) { ntt_test(); }
+TEST(NumetronTest, to_string) { to_string_test(); }
+TEST(NumetronTest, from_string) { from_string_test(); }
+TEST(NumetronTest, div) { div_test(); }
+TEST(NumetronTest, montgomery) { montgomery_test(); }
+TEST(NumetronTest, integer_expression) { integer_expression_test(); }
+TEST(NumetronTest, gcd) { gcd_test(); }
+TEST(NumetronTest, root) { root_test(); }
+TEST(NumetronTest, prime) { prime_test(); }
+TEST(NumetronTest, combinatorics) { combinatorics_test(); }
+TEST(NumetronTest, ifma) { ifma_test(); }
+TEST(NumetronTest, batch_mul) { batch_mul_test(); }
 
 #else
 TEST(NumetronTest, mul) { mul_test(); }
@@ -0,0 +1,99 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+void to_string_test()
+{
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+
+    std::mt19937_64 rng{ 0x0105 };
+
+    // sizes around the divide and conquer threshold and well above it; the sparse pattern
+    // makes long runs of zero digits that the padding of the low halves has to restore
+    for (size_t n : { (size_t)1, (size_t)2, (size_t)NUMETRON_GET_STR_DC_THRESHOLD - 1, (size_t)NUMETRON_GET_STR_DC_THRESHOLD,
+        (size_t)NUMETRON_GET_STR_DC_THRESHOLD + 1, (size_t)100, (size_t)257, (size_t)1500 }) {
+        for (unsigned int base : { 10, 3, 7, 36 }) {
+            for (int pattern = 0; pattern < 3; ++pattern) {
+                std::vector<uint64_t> u(n);
+                for (auto& l : u) {
+                    l = pattern == 0 ? rng() : (pattern == 1 ? ~uint64_t{ 0 } : (rng() % 5 ? 0 : rng()));
+                }
+                u.back() |= 1;
+
+                mpz_t z;
+                mpz_init(z);
+                mpz_import(z, n, -1, sizeof(uint64_t), 0, 0, u.data());
+                std::string ref(mpz_sizeinbase(z, (int)base) + 2, '\0');
+                mpz_get_str(ref.data(), (int)base, z);
+                ref.resize(std::strlen(ref.c_str()));
+                mpz_clear(z);
+
+                std::string res;
+                bool reversed;
+                to_string(std::span<uint64_t>{ u }, std::back_inserter(res), reversed, base);
+                if (reversed) std::reverse(res.begin(), res.end());
+                CHECK(res == ref);
+            }
+        }
+    }
+
+    // the power tables are shared: concurrent conversions in a base that has not been used yet grow its table together
+    {
+        const unsigned int base = 11;
+        std::vector<std::vector<uint64_t>> numbers;
+        std::vector<std::string> refs;
+        for (size_t n : { 3000, 700, 1500, 90 }) {
+            std::vector<uint64_t> u(n);
+            for (auto& l : u) l = rng();
+            u.back() |= 1;
+            mpz_t z;
+            mpz_init(z);
+            mpz_import(z, n, -1, sizeof(uint64_t), 0, 0, u.data());
+            std::string ref(mpz_sizeinbase(z, (int)base) + 2, '\0');
+            mpz_get_str(ref.data(), (int)base, z);
+            ref.resize(std::strlen(ref.c_str()));
+            mpz_clear(z);
+            numbers.push_back(std::move(u));
+            refs.push_back(std::move(ref));
+        }
+
+        std::vector<char> ok(4, 0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < ok.size(); ++t) {
+            threads.emplace_back([&numbers, &refs, &ok, t, base] {
+                bool all = true;
+                for (size_t k = 0; k < numbers.size(); ++k) {
+                    size_t j = (k + t) % numbers.size();
+                    std::vector<uint64_t> u = numbers[j];
+                    std::string res;
+                    bool reversed;
+                    to_string(std::span<uint64_t>{ u }, std::back_inserter(res), reversed, base);
+                    if (reversed) std::reverse(res.begin(), res.end());
+                    all = all && res == refs[j];
+                }
+                ok[t] = all;
+            });
+        }
+        for (auto& th : threads) th.join();
+        for (char r : ok) CHECK(r);
+    }
+}
+
+}
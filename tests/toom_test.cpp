@@ -0,0 +1,142 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
+#   pragma warning(disable : 4244 4146)
+#endif
+#include "gmp.h"
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron {
+
+namespace {
+
+std::vector<uint64_t> make_operand(std::mt19937_64& rng, size_t n, int pattern)
+{
+    std::vector<uint64_t> u(n);
+    for (auto& l : u) {
+        l = pattern == 0 ? rng() : (pattern == 1 ? ~uint64_t{ 0 } : (rng() & 0xff));
+    }
+    u.back() |= 1; // keep the top limb significant
+    return u;
+}
+
+template <typename MulT>
+void check_mul(std::mt19937_64& rng, size_t un, size_t vn, MulT&& mul)
+{
+    for (int pattern = 0; pattern < 3; ++pattern) {
+        auto u = make_operand(rng, un, pattern);
+        auto v = make_operand(rng, vn, pattern);
+        std::vector<uint64_t> r(un + vn), ref(un + vn);
+        mul(u.data(), un, v.data(), vn, r.data());
+        mpn_mul(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un,
+            reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)vn);
+        CHECK(r == ref);
+    }
+}
+
+template <typename SqrT>
+void check_sqr(std::mt19937_64& rng, size_t n, SqrT&& sqr)
+{
+    for (int pattern = 0; pattern < 3; ++pattern) {
+        auto u = make_operand(rng, n, pattern);
+        std::vector<uint64_t> r(2 * n), ref(2 * n);
+        sqr(u.data(), n, r.data());
+        mpn_sqr(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)n);
+        CHECK(r == ref);
+    }
+}
+
+}
+
+void toom_test()
+{
+    using namespace numetron::limb_arithmetic;
+    static_assert(sizeof(mp_limb_t) == sizeof(uint64_t));
+
+    std::mt19937_64 rng{ 0x7004 };
+    std::allocator<uint64_t> alloc;
+
+    auto engine_mul = [&alloc]<size_t N, size_t M>() {
+        return [&alloc](uint64_t const* u, size_t un, uint64_t const* v, size_t vn, uint64_t* r) {
+            toom_engine<N, M>::umul(u, un, v, vn, r, alloc);
+        };
+    };
+    auto engine_sqr = [&alloc]<size_t N>() {
+        return [&alloc](uint64_t const* u, size_t n, uint64_t* r) {
+            toom_sqr_engine<N>::usqr(u, n, r, alloc);
+        };
+    };
+
+    // the generated plans at one level, below their dispatch thresholds, balanced and unbalanced
+    for (size_t vn : { 100, 101, 257, 600 }) {
+        for (size_t un : { vn, vn + 1, vn + vn / 3 }) {
+            check_mul(rng, un, vn, engine_mul.template operator()<4, 4>());
+            check_mul(rng, un, vn, engine_mul.template operator()<6, 6>());
+            check_mul(rng, un, vn, engine_mul.template operator()<8, 8>());
+        }
+        // Toom-6.5 splits u into 7 pieces once u_6 is not empty
+        for (size_t un : { vn + vn / 6 + 7, vn + vn / 3 }) {
+            check_mul(rng, un, vn, engine_mul.template operator()<7, 6>());
+        }
+        check_sqr(rng, vn, engine_sqr.template operator()<4>());
+        check_sqr(rng, vn, engine_sqr.template operator()<6>());
+        check_sqr(rng, vn, engine_sqr.template operator()<8>());
+    }
+
+    // unbalanced plans, u is N / M times longer than v and a bit off that ratio
+    for (size_t vn : { 100, 101, 257 }) {
+        for (size_t un : { vn + vn / 3, vn + vn / 2 }) {
+            check_mul(rng, un, vn, engine_mul.template operator()<4, 3>());
+        }
+        for (size_t un : { vn + vn / 2, 2 * vn, 2 * vn + 5 }) {
+            check_mul(rng, un, vn, engine_mul.template operator()<3, 2>());
+        }
+        for (size_t un : { 7 * vn / 4, 2 * vn, 3 * vn - 1 }) {
+            check_mul(rng, un, vn, engine_mul.template operator()<4, 2>());
+        }
+    }
+
+    // dispatch just above every new threshold
+    auto dispatch_mul = [&alloc](uint64_t const* u, size_t un, uint64_t const* v, size_t vn, uint64_t* r) {
+        umul_dispatch(u, un, v, vn, r, alloc);
+    };
+    auto dispatch_sqr = [&alloc](uint64_t const* u, size_t n, uint64_t* r) {
+        usqr_dispatch(u, n, r, alloc);
+    };
+    for (size_t thr : { (size_t)NUMETRON_TOOM4_THRESHOLD, (size_t)NUMETRON_TOOM6H_THRESHOLD, (size_t)NUMETRON_TOOM8_THRESHOLD }) {
+        check_mul(rng, thr, thr, dispatch_mul);
+        check_mul(rng, thr + thr / 5, thr + 1, dispatch_mul);
+    }
+    for (size_t thr : { (size_t)NUMETRON_TOOM32_THRESHOLD, (size_t)NUMETRON_TOOM42_THRESHOLD, (size_t)NUMETRON_TOOM43_THRESHOLD }) {
+        for (size_t un : { thr + thr / 4, thr + thr / 2, 7 * thr / 4, 3 * thr - 1 }) {
+            check_mul(rng, un, thr, dispatch_mul);
+        }
+    }
+
+    // long u is multiplied in pieces; a zero piece in the middle of u must not shorten the result
+    for (auto [un, vn] : { std::pair<size_t, size_t>{ 3000, 400 }, { 1000, 80 }, { 3 * 90, 90 }, { 7 * 100 + 3, 100 } }) {
+        check_mul(rng, un, vn, dispatch_mul);
+        auto u = make_operand(rng, un, 0);
+        auto v = make_operand(rng, vn, 0);
+        std::fill(u.begin() + vn / 2, u.begin() + 5 * vn / 2, 0);
+        std::vector<uint64_t> r(un + vn, ~uint64_t{ 0 }), ref(un + vn);
+        umul_dispatch(u.data(), un, v.data(), vn, r.data(), alloc);
+        mpn_mul(reinterpret_cast<mp_limb_t*>(ref.data()), reinterpret_cast<mp_limb_t const*>(u.data()), (mp_size_t)un,
+            reinterpret_cast<mp_limb_t const*>(v.data()), (mp_size_t)vn);
+        CHECK(r == ref);
+    }
+
+    for (size_t thr : { (size_t)NUMETRON_SQR_TOOM4_THRESHOLD, (size_t)NUMETRON_SQR_TOOM6_THRESHOLD, (size_t)NUMETRON_SQR_TOOM8_THRESHOLD }) {
+        check_sqr(rng, thr + 1, dispatch_sqr);
+    }
+}
+
+}
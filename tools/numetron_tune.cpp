@@ -0,0 +1,239 @@
+// Numetron — Compile-time and runtime arbitrary-precision arithmetic
+// (c) 2025 Alexander Pototskiy
+// Licensed under the MIT License. See LICENSE file for details.
+
+// numetron_tune measures the sizes from which the faster asymptotic algorithms win on the running machine and writes
+// them as a header of threshold macros:
+//
+//     numetron_tune [-o <header>] [--quick]
+//
+// The build picks the header up when NUMETRON_TUNED_THRESHOLDS_HEADER names it, see toom/thresholds.hpp; in CMake
+// that is -DNUMETRON_TUNED_THRESHOLDS=<header>. A header per target architecture keeps a mixed fleet tuned.
+//
+// Every threshold is found as in GMP's tuneup: at the size n the operation runs once with the threshold n + 1, where the
+// algorithm is off at the top level, and once with the threshold n, where it is taken at the top level and the pieces
+// go below it. The thresholds of this tool are variables while it runs, the ones above the threshold being measured
+// are switched off, the ones below it are already tuned.
+
+#include <cstddef>
+#include <limits>
+
+namespace numetron_tune {
+
+struct thresholds
+{
+    static constexpr size_t off = (std::numeric_limits<size_t>::max)() / 16;
+
+    size_t karatsuba = off;
+    size_t toom3 = off;
+    size_t sqr_karatsuba = off;
+    size_t sqr_toom3 = off;
+    size_t inv_newton = off;
+    size_t div_newton = off;
+    size_t get_str_dc = off;
+    size_t set_str_dc = off;
+};
+
+thresholds current;
+
+}
+
+#define NUMETRON_KARATSUBA_THRESHOLD ::numetron_tune::current.karatsuba
+#define NUMETRON_TOOM3_THRESHOLD ::numetron_tune::current.toom3
+#define NUMETRON_SQR_KARATSUBA_THRESHOLD ::numetron_tune::current.sqr_karatsuba
+#define NUMETRON_SQR_TOOM3_THRESHOLD ::numetron_tune::current.sqr_toom3
+#define NUMETRON_INV_NEWTON_THRESHOLD ::numetron_tune::current.inv_newton
+#define NUMETRON_DIV_NEWTON_THRESHOLD ::numetron_tune::current.div_newton
+#define NUMETRON_GET_STR_DC_THRESHOLD ::numetron_tune::current.get_str_dc
+#define NUMETRON_SET_STR_DC_THRESHOLD ::numetron_tune::current.set_str_dc
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "numetron/basic_integer.hpp"
+
+namespace numetron_tune {
+
+using namespace numetron;
+using namespace numetron::limb_arithmetic;
+
+struct options
+{
+    std::string output = "numetron_thresholds.hpp";
+    std::chrono::nanoseconds round_time{ std::chrono::milliseconds{ 20 } };
+    int rounds = 5;
+};
+
+options opts;
+std::mt19937_64 rng{ 0x7E57 };
+
+std::vector<uint64_t> random_limbs(size_t n)
+{
+    std::vector<uint64_t> r(n);
+    for (auto& l : r) l = rng();
+    r.back() |= uint64_t{ 1 } << 63;
+    return r;
+}
+
+integer to_integer(std::vector<uint64_t> const& limbs)
+{
+    return integer{ basic_integer_view<uint64_t>{ std::span<const uint64_t>{ limbs } } };
+}
+
+// the time of one call of f in nanoseconds, the best of opts.rounds rounds of at least opts.round_time each
+template <typename F>
+double measure(F&& f)
+{
+    using clock = std::chrono::steady_clock;
+    size_t reps = 1;
+    for (;;) {
+        const auto t0 = clock::now();
+        for (size_t i = 0; i < reps; ++i) f();
+        if (clock::now() - t0 >= opts.round_time / 8) break;
+        reps *= 2;
+    }
+    reps *= 8;
+    double best = (std::numeric_limits<double>::max)();
+    for (int r = 0; r < opts.rounds; ++r) {
+        const auto t0 = clock::now();
+        for (size_t i = 0; i < reps; ++i) f();
+        const std::chrono::duration<double, std::nano> t = clock::now() - t0;
+        best = (std::min)(best, t.count() / static_cast<double>(reps));
+    }
+    return best;
+}
+
+// the smallest size in [lo, hi] from which the algorithm behind threshold wins at three consecutive sizes,
+// hi + 1 if it never does; make(n) prepares the operands and returns the operation
+template <typename MakeF>
+size_t crossover(char const* name, size_t& threshold, size_t lo, size_t hi, MakeF const& make)
+{
+    size_t first = hi + 1, wins = 0;
+    for (size_t n = lo; n <= hi; n += (std::max)(size_t{ 1 }, n / 16)) {
+        auto op = make(n);
+        threshold = n + 1;
+        const double off = measure(op);
+        threshold = n;
+        const double on = measure(op);
+        std::printf("%-16s %6zu: %12.0f ns %12.0f ns %+6.1f%%\n", name, n, off, on, 100.0 * (off - on) / off);
+        if (on < off) {
+            if (!wins++) first = n;
+            if (wins == 3) break;
+        } else {
+            wins = 0;
+            first = hi + 1;
+        }
+    }
+    threshold = first;
+    if (first > hi) {
+        std::printf("%-16s -> %zu, no crossover up to %zu\n", name, first, hi);
+    } else {
+        std::printf("%-16s -> %zu\n", name, first);
+    }
+    return first;
+}
+
+void tune()
+{
+    // every operation owns its operands, so both runs at a size work on the same numbers
+    std::allocator<uint64_t> alloc;
+
+    crossover("karatsuba", current.karatsuba, 8, 200, [&](size_t n) {
+        return [u = random_limbs(n), v = random_limbs(n), r = std::vector<uint64_t>(2 * n), alloc]() mutable {
+            umul_dispatch(u.data(), u.size(), v.data(), v.size(), r.data(), alloc);
+        };
+    });
+    crossover("toom3", current.toom3, current.karatsuba * 2, 800, [&](size_t n) {
+        return [u = random_limbs(n), v = random_limbs(n), r = std::vector<uint64_t>(2 * n), alloc]() mutable {
+            umul_dispatch(u.data(), u.size(), v.data(), v.size(), r.data(), alloc);
+        };
+    });
+    crossover("sqr_karatsuba", current.sqr_karatsuba, 8, 300, [&](size_t n) {
+        return [u = random_limbs(n), r = std::vector<uint64_t>(2 * n), alloc]() mutable {
+            usqr_dispatch(u.data(), u.size(), r.data(), alloc);
+        };
+    });
+    crossover("sqr_toom3", current.sqr_toom3, current.sqr_karatsuba * 2, 1000, [&](size_t n) {
+        return [u = random_limbs(n), r = std::vector<uint64_t>(2 * n), alloc]() mutable {
+            usqr_dispatch(u.data(), u.size(), r.data(), alloc);
+        };
+    });
+    crossover("inv_newton", current.inv_newton, 4, 300, [&](size_t n) {
+        return [d = random_limbs(n), x = std::vector<uint64_t>(n), alloc]() mutable {
+            uinv<uint64_t>(d.data(), d.size(), x.data(), alloc);
+        };
+    });
+    crossover("div_newton", current.div_newton, 8, 400, [&](size_t n) {
+        return [u = random_limbs(2 * n), v = random_limbs(n), q = std::vector<uint64_t>(2 * n), r = std::vector<uint64_t>(n)]() mutable {
+            udiv<uint64_t>(u, v, q, r);
+        };
+    });
+    crossover("get_str_dc", current.get_str_dc, 2, 200, [&](size_t n) {
+        return [x = to_integer(random_limbs(n))] { (void)to_string(x); };
+    });
+    crossover("set_str_dc", current.set_str_dc, 2, 400, [&](size_t n) {
+        return [s = to_string(to_integer(random_limbs(n)))] { (void)integer{ s }; };
+    });
+}
+
+void write_header(std::ostream& os)
+{
+    os << "// Numetron thresholds measured by numetron_tune";
+#if defined(NUMETRON_USE_ASM) && (defined(__x86_64__) || defined(_M_X64)) && defined(NUMETRON_PLATFORM_AUTODETECT)
+    char descriptor[32];
+    std::snprintf(descriptor, sizeof descriptor, "0x%llx", static_cast<unsigned long long>(numetron_detect_platform()));
+    os << " on the platform " << descriptor;
+#endif
+    os << "\n\n#pragma once\n";
+
+    auto emit = [&os](char const* macro, size_t value) {
+        if (value >= thresholds::off) return;
+        os << "\n#ifndef " << macro << "\n#   define " << macro << ' ' << value << "\n#endif\n";
+    };
+    emit("NUMETRON_KARATSUBA_THRESHOLD", current.karatsuba);
+    emit("NUMETRON_TOOM3_THRESHOLD", current.toom3);
+    emit("NUMETRON_SQR_KARATSUBA_THRESHOLD", current.sqr_karatsuba);
+    emit("NUMETRON_SQR_TOOM3_THRESHOLD", current.sqr_toom3);
+    emit("NUMETRON_INV_NEWTON_THRESHOLD", current.inv_newton);
+    emit("NUMETRON_DIV_NEWTON_THRESHOLD", current.div_newton);
+    emit("NUMETRON_GET_STR_DC_THRESHOLD", current.get_str_dc);
+    emit("NUMETRON_SET_STR_DC_THRESHOLD", current.set_str_dc);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace numetron_tune;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") && i + 1 < argc) {
+            opts.output = argv[++i];
+        } else if (!std::strcmp(argv[i], "--quick")) {
+            opts.round_time = std::chrono::milliseconds{ 2 };
+            opts.rounds = 3;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [-o <header>] [--quick]\n";
+            return 2;
+        }
+    }
+
+    tune();
+
+    std::ofstream file{ opts.output };
+    write_header(file);
+    if (!file) {
+        std::cerr << "cannot write " << opts.output << "\n";
+        return 1;
+    }
+    std::cout << "written " << opts.output << "\n";
+    return 0;
+}